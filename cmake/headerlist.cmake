@@ -1,14 +1,29 @@
 set(headers ${headers}
 	include/Cache.h
+	include/CallTrace.h
 	include/Debug.h
+	include/FormCatalog.h
+	include/FormResolver.h
 	include/FormSwap.h
 	include/FormSwapMap.h
+	include/FormSwapParser.h
+	include/HookStats.h
 	include/LODSwap.h
 	include/LandscapeSwap.h
+	include/Manifest.h
+	include/MemoryStats.h
+	include/OriginalBases.h
 	include/PCH.h
 	include/Papyrus.h
+	include/PerfectHash.h
+	include/Persistence.h
 	include/SeasonManager.h
+	include/SeasonSwaps.h
 	include/Seasons.h
+	include/Serialization.h
 	include/SnowSwap.h
+	include/StringSearch.h
+	include/SwapGenerator.h
+	include/Trace.h
 	include/Util.h
 )
@@ -1,10 +1,25 @@
 set(sources ${sources}
 	src/Cache.cpp
+	src/CallTrace.cpp
+	src/FormCatalog.cpp
+	src/FormResolver.cpp
 	src/FormSwapMap.cpp
+	src/FormSwapParser.cpp
+	src/HookStats.cpp
+	src/Manifest.cpp
+	src/MemoryStats.cpp
+	src/OriginalBases.cpp
 	src/PCH.cpp
 	src/Papyrus.cpp
+	src/PerfectHash.cpp
+	src/Persistence.cpp
 	src/SeasonManager.cpp
+	src/SeasonSwaps.cpp
 	src/Seasons.cpp
+	src/Serialization.cpp
 	src/SnowSwap.cpp
+	src/StringSearch.cpp
+	src/SwapGenerator.cpp
+	src/Trace.cpp
 	src/main.cpp
 )
@@ -2,6 +2,8 @@
 
 namespace Cache
 {
+	namespace TXST = FormCatalog::TXST;
+
 	class DataHolder : public REX::Singleton<DataHolder>
 	{
 	public:
@@ -10,17 +12,32 @@ namespace Cache
 		RE::TESLandTexture* GetLandTextureFromTextureSet(const RE::BGSTextureSet* a_txst);
 		[[nodiscard]] bool  IsSnowShader(const RE::TESForm* a_form) const;
 
+		[[nodiscard]] const FormCatalog::Catalog& GetCatalog() const { return _catalog; }
+
 		RE::TESBoundObject* GetOriginalBase(RE::TESObjectREFR* a_ref);
 		void                SetOriginalBase(const RE::TESObjectREFR* a_ref, const RE::TESBoundObject* a_originalBase);
+		//stops tracking a_ref and puts its original base back, GetHandle swaps it again if it reattaches
+		//only call once a_ref is detached and its 3D is gone
+		void                RestoreOriginalBase(RE::TESObjectREFR* a_ref);
+		//true if a_ref was swapped and hasn't been restored yet
+		bool                IsTracked(const RE::TESObjectREFR* a_ref) const;
+
+		void GetMemoryStats(std::vector<MemoryStats::Table>& a_tables) const;
 
 	private:
-		using Lock = std::shared_mutex;
-		using Locker = std::scoped_lock<Lock>;
+		static std::uint8_t classify_texture_set(const RE::BGSTextureSet* a_txst);
+		//catalog building only, _textureSetFlags is released once the catalog has the per row flags
+		std::uint8_t        GetTextureSetFlags(const RE::BGSTextureSet* a_txst) const;
+
+		template <class T>
+		void add_to_catalog(RE::TESDataHandler* a_dataHandler, FormCatalog::TYPE a_type);
+		void build_catalog(RE::TESDataHandler* a_dataHandler);
 
-		MapPair<RE::FormID> _textureToLandMap;
-		Set<RE::FormID>     _snowShaders;
+		MapPair<RE::FormID>           _textureToLandMap;
+		Set<RE::FormID>               _snowShaders;
+		Map<RE::FormID, std::uint8_t> _textureSetFlags;  // scratch for build_catalog, texture sets are shared by many forms
+		FormCatalog::Catalog          _catalog;
 
-		mutable Lock        _originalsLock;
-		MapPair<RE::FormID> _originals;
+		OriginalBases::Tracker _originals;
 	};
 }
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+// Compact binary log of the forms the hot hooks are called with during play
+// Replayed against the swap tables outside the game by tools/CallReplay, so it only depends on the standard library.
+namespace CallTrace
+{
+	enum class HOOK : std::uint8_t
+	{
+		kGetHandle = 0,          // form: reference, base: original base object
+		kStaticsClone3D,         // form: reference, base: static
+		kIsConsideredSnow,       // form: land texture
+		kGetSpecularComponent,   // form: land texture
+		kGetAsShaderTextureSet,  // form: texture set
+
+		kTotal
+	};
+
+	inline constexpr std::array<const char*, static_cast<std::size_t>(HOOK::kTotal)> hookNames{
+		"GetHandle",
+		"Statics::Clone3D",
+		"IsConsideredSnow",
+		"GetSpecularComponent",
+		"GetAsShaderTextureSet"
+	};
+
+	struct Record
+	{
+		HOOK          hook{ HOOK::kTotal };
+		std::uint8_t  season{ 0 };  // SEASON
+		std::uint16_t reserved{ 0 };
+		std::uint32_t worldspace{ 0 };
+		std::uint32_t form{ 0 };
+		std::uint32_t base{ 0 };
+	};
+	static_assert(sizeof(Record) == 16);
+
+	// 'SOSC', version, then records until the end of the file
+	// records are in call order per thread, each thread's records are written a buffer at a time
+	inline constexpr std::uint32_t magic = 0x43534F53;
+	inline constexpr std::uint32_t version = 1;
+
+	class Recorder
+	{
+	public:
+		static Recorder& GetSingleton()
+		{
+			static Recorder singleton;
+			return singleton;
+		}
+
+		Recorder(const Recorder&) = delete;
+		Recorder(Recorder&&) = delete;
+		~Recorder();
+
+		Recorder& operator=(const Recorder&) = delete;
+		Recorder& operator=(Recorder&&) = delete;
+
+		// truncates a_path
+		bool Start(const std::filesystem::path& a_path);
+		void Stop();
+
+		// checked by hooks before gathering anything to record
+		[[nodiscard]] bool IsRecording() const { return _recording.load(std::memory_order_relaxed); }
+
+		// appends to the calling thread's buffer, full buffers are written by the writer thread
+		void Record(const CallTrace::Record& a_record);
+		// writes every thread's buffer and waits until it is on disk
+		void Flush();
+
+	private:
+		using Buffer = std::vector<CallTrace::Record>;
+
+		// only contended while Flush or Stop takes the records
+		struct ThreadBuffer
+		{
+			std::mutex lock;
+			Buffer     records;
+		};
+
+		Recorder() = default;
+
+		ThreadBuffer& get_thread_buffer();
+		void          submit(Buffer&& a_buffer);
+		void          collect();
+		void          write(const Buffer& a_buffer);
+		void          Run(std::stop_token a_stop);
+
+		static constexpr std::size_t bufferSize = 1 << 12;  // 64 KB per thread
+
+		std::atomic_bool _recording{ false };
+		std::mutex       _lock;  // Start, Stop and Flush
+
+		std::mutex                                 _threadsLock;
+		std::vector<std::unique_ptr<ThreadBuffer>> _threads;
+
+		std::mutex                  _queueLock;
+		std::condition_variable_any _queued;
+		std::condition_variable     _drained;
+		std::vector<Buffer>         _queue;
+		bool                        _writing{ false };
+
+		std::ofstream _file;  // only the writer thread writes records while recording
+		std::jthread  _writer;
+	};
+
+	// false if the header doesn't match, a truncated last record is dropped
+	bool Read(std::istream& a_stream, std::vector<Record>& a_records);
+}
@@ -1,10 +1,37 @@
 #pragma once
 
+#include "HookStats.h"
 #include "SeasonManager.h"
 
 namespace Debug
 {
 	namespace detail
+	{
+		//never pass a_text as the format, report lines contain '%'
+		void print(const char* a_text)
+		{
+			if (RE::ConsoleLog::IsConsoleMode()) {
+				RE::ConsoleLog::GetSingleton()->Print("%s", a_text);
+			}
+		}
+
+		void install_command(const char* a_target, std::string_view a_longName, std::string_view a_shortName, const std::string& a_help, RE::SCRIPT_FUNCTION::Execute_t* a_execute)
+		{
+			if (const auto function = RE::SCRIPT_FUNCTION::LocateConsoleCommand(a_target); function) {
+				function->functionName = a_longName.data();
+				function->shortName = a_shortName.data();
+				function->helpString = a_help.data();
+				function->referenceFunction = false;
+				function->SetParameters();
+				function->executeFunction = a_execute;
+				function->conditionFunction = nullptr;
+
+				logger::debug("installed {}", a_longName);
+			}
+		}
+	}
+
+	namespace LandTexture
 	{
 		constexpr auto LONG_NAME = "GetLandTexture"sv;
 		constexpr auto SHORT_NAME = "GLT"sv;
@@ -21,11 +48,7 @@ namespace Debug
 
 		bool Execute(const RE::SCRIPT_PARAMETER*, RE::SCRIPT_FUNCTION::ScriptData*, RE::TESObjectREFR*, RE::TESObjectREFR*, RE::Script*, RE::ScriptLocals*, double&, std::uint32_t&)
 		{
-			constexpr auto print = [](const char* a_fmt) {
-				if (RE::ConsoleLog::IsConsoleMode()) {
-					RE::ConsoleLog::GetSingleton()->Print(a_fmt);
-				}
-			};
+			using detail::print;
 
 			if (const auto LT = RE::TES::GetSingleton()->GetLandTexture(RE::PlayerCharacter::GetSingleton()->GetPosition())) {
 				const auto swappedLT = SeasonManager::GetSingleton()->GetSwapLandTexture(LT);
@@ -42,18 +65,111 @@ namespace Debug
 		}
 	}
 
+	//per-hook timings, only recorded in HOOK_STATS builds
+	namespace Hooks
+	{
+		constexpr auto LONG_NAME = "GetSeasonsHookStats"sv;
+		constexpr auto SHORT_NAME = "GSHS"sv;
+
+		[[nodiscard]] const std::string& HelpString()
+		{
+			static auto help = []() {
+				std::string buf;
+				buf += "Print Seasons of Skyrim hook call counts, swap hit rate and latency, and write them to the log\n";
+				return buf;
+			}();
+			return help;
+		}
+
+		bool Execute(const RE::SCRIPT_PARAMETER*, RE::SCRIPT_FUNCTION::ScriptData*, RE::TESObjectREFR*, RE::TESObjectREFR*, RE::Script*, RE::ScriptLocals*, double&, std::uint32_t&)
+		{
+			const auto report = HookStats::GetReport();
+			if (report.empty()) {
+				detail::print("no hook calls recorded");
+				return true;
+			}
+
+			logger::info("{:*^30}", "HOOK STATS");
+			for (const auto& line : report) {
+				detail::print(line.c_str());
+				logger::info("{}", line);
+			}
+
+			return true;
+		}
+	}
+
+	//worst cells by hook time, only recorded in HOOK_STATS builds
+	namespace Cells
+	{
+		constexpr auto LONG_NAME = "GetSeasonsCellStats"sv;
+		constexpr auto SHORT_NAME = "GSCS"sv;
+
+		constexpr std::size_t count = 20;
+
+		[[nodiscard]] const std::string& HelpString()
+		{
+			static auto help = []() {
+				std::string buf;
+				buf += "Print the cells where Seasons of Skyrim hooks spent the most time, with swaps, snow classifications, double clones and land texture lookups, and write them to the log\n";
+				return buf;
+			}();
+			return help;
+		}
+
+		bool Execute(const RE::SCRIPT_PARAMETER*, RE::SCRIPT_FUNCTION::ScriptData*, RE::TESObjectREFR*, RE::TESObjectREFR*, RE::Script*, RE::ScriptLocals*, double&, std::uint32_t&)
+		{
+			const auto report = HookStats::GetCellReport(count);
+			if (report.empty()) {
+				detail::print("no cell costs recorded");
+				return true;
+			}
+
+			logger::info("{:*^30}", "CELL STATS");
+			for (const auto& line : report) {
+				detail::print(line.c_str());
+				logger::info("{}", line);
+			}
+
+			return true;
+		}
+	}
+
+	namespace Memory
+	{
+		constexpr auto LONG_NAME = "GetSeasonsMemoryStats"sv;
+		constexpr auto SHORT_NAME = "GSMS"sv;
+
+		[[nodiscard]] const std::string& HelpString()
+		{
+			static auto help = []() {
+				std::string buf;
+				buf += "Print entries, buckets and approximate size of Seasons of Skyrim lookup tables, and write them to the log\n";
+				return buf;
+			}();
+			return help;
+		}
+
+		bool Execute(const RE::SCRIPT_PARAMETER*, RE::SCRIPT_FUNCTION::ScriptData*, RE::TESObjectREFR*, RE::TESObjectREFR*, RE::Script*, RE::ScriptLocals*, double&, std::uint32_t&)
+		{
+			logger::info("{:*^30}", "MEMORY");
+			for (const auto& line : MemoryStats::GetReport()) {
+				detail::print(line.c_str());
+				logger::info("\t{}", line);
+			}
+
+			return true;
+		}
+	}
+
 	void Install()
 	{
-		if (const auto function = RE::SCRIPT_FUNCTION::LocateConsoleCommand("SetStackDepth"); function) {
-			function->functionName = detail::LONG_NAME.data();
-			function->shortName = detail::SHORT_NAME.data();
-			function->helpString = detail::HelpString().data();
-			function->referenceFunction = false;
-			function->SetParameters();
-			function->executeFunction = &detail::Execute;
-			function->conditionFunction = nullptr;
-
-			logger::debug("installed {}", detail::LONG_NAME);
+		detail::install_command("SetStackDepth", LandTexture::LONG_NAME, LandTexture::SHORT_NAME, LandTexture::HelpString(), &LandTexture::Execute);
+		detail::install_command("DumpNiUpdates", Memory::LONG_NAME, Memory::SHORT_NAME, Memory::HelpString(), &Memory::Execute);
+
+		if constexpr (HookStats::enabled) {
+			detail::install_command("DumpTexturePalette", Hooks::LONG_NAME, Hooks::SHORT_NAME, Hooks::HelpString(), &Hooks::Execute);
+			detail::install_command("ShowRenderPasses", Cells::LONG_NAME, Cells::SHORT_NAME, Cells::HelpString(), &Cells::Execute);
 		}
 	}
 }
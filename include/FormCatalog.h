@@ -0,0 +1,136 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ankerl/unordered_dense.h>
+
+// Snapshot of every form that swap generation looks at, stored column-wise
+// Built once at kDataLoaded; only depends on the standard library so it can be saved, loaded and generated from outside the game.
+namespace FormCatalog
+{
+	// generated record types, in FormSwapMap::standardTypes order
+	enum class TYPE : std::uint8_t
+	{
+		kLandTexture = 0,
+		kActivator,
+		kFurniture,
+		kMovableStatic,
+		kStatic,
+		kTree,
+
+		kTotal
+	};
+
+	// texture set classification, from textures[0] (diffuse) path
+	namespace TXST
+	{
+		enum FLAG : std::uint8_t
+		{
+			kNone = 0,
+			kSnow = 1 << 0,
+			kMask = 1 << 1,
+			kFrozen = 1 << 2
+		};
+	}
+
+	// land texture material, reduced to what snow variant generation switches on
+	enum class LAND_MATERIAL : std::uint8_t
+	{
+		kOther = 0,
+		kGrass,
+		kDirt,
+		kStone,  // stone, broken stone, gravel
+		kNoSnowVariant  // snow, ice, sand, mud
+	};
+
+	namespace ROW
+	{
+		enum FLAG : std::uint8_t
+		{
+			kNone = 0,
+			kHasGrass = 1 << 0,      // land texture with a grass list
+			kSnowMaterial = 1 << 1   // static with a snow material object
+		};
+	}
+
+	using StringID = std::uint32_t;  // index into the string table, 0 is ""
+
+	class Catalog
+	{
+	public:
+		struct Row
+		{
+			std::uint32_t                 formID{ 0 };
+			std::uint32_t                 localFormID{ 0 };
+			TYPE                          type{ TYPE::kTotal };
+			std::string_view              file{};
+			std::string_view              model{};
+			std::string_view              editorID{};
+			std::uint32_t                 material{ 0 };  // material object FormID, or LAND_MATERIAL for land textures
+			std::uint8_t                  flags{ ROW::kNone };
+			std::span<const std::uint8_t> altTextures{};  // TXST flags per alternate texture, 0 if it has no texture set
+		};
+
+		Catalog() { clear(); }
+
+		void clear();
+
+		// a_row.model is lowercased on insertion
+		std::uint32_t add(const Row& a_row);
+
+		[[nodiscard]] std::size_t                  size() const { return formIDs.size(); }
+		[[nodiscard]] std::optional<std::uint32_t> find(std::uint32_t a_formID) const;
+		[[nodiscard]] std::vector<std::uint32_t>   get_rows(TYPE a_type) const;
+
+		[[nodiscard]] std::string_view              get_string(StringID a_id) const { return strings[a_id]; }
+		[[nodiscard]] std::string_view              get_model(std::uint32_t a_row) const { return strings[models[a_row]]; }
+		[[nodiscard]] std::string_view              get_editorID(std::uint32_t a_row) const { return strings[editorIDs[a_row]]; }
+		[[nodiscard]] std::string_view              get_file(std::uint32_t a_row) const { return fileNames[files[a_row]]; }
+		[[nodiscard]] std::span<const std::uint8_t> get_alt_textures(std::uint32_t a_row) const;
+
+		// TXST queries over a row's alternate textures, a texture matches if it has any of a_flags
+		[[nodiscard]] bool contains_textureset(std::uint32_t a_row, std::uint8_t a_flags) const;
+		[[nodiscard]] bool only_contains_textureset(std::uint32_t a_row, std::uint8_t a_flags) const;       // true if there are no alternate textures
+		[[nodiscard]] bool must_only_contain_textureset(std::uint32_t a_row, std::uint8_t a_flags) const;  // false if there are no alternate textures
+
+		// approximate heap bytes of the columns, string table and indexes
+		[[nodiscard]] std::size_t get_memory_usage() const;
+
+		bool Save(std::ostream& a_stream) const;
+		bool Load(std::istream& a_stream);
+
+		// fnv1a of the lowercase basename, including the leading separator
+		static std::uint64_t hash_basename(std::string_view a_model);
+
+		// columns, one entry per row
+		std::vector<std::uint32_t> formIDs;
+		std::vector<std::uint32_t> localFormIDs;
+		std::vector<TYPE>          types;
+		std::vector<std::uint16_t> files;  // index into fileNames
+		std::vector<StringID>      models;
+		std::vector<std::uint64_t> basenameHashes;
+		std::vector<StringID>      editorIDs;
+		std::vector<std::uint32_t> materials;
+		std::vector<std::uint8_t>  rowFlags;
+		std::vector<std::uint32_t> altTextureOffsets;  // size() + 1 entries into altTextureFlags
+
+		std::vector<std::uint8_t> altTextureFlags;
+		std::vector<std::string>  fileNames;
+		std::vector<std::string>  strings;
+
+	private:
+		StringID      intern(std::string_view a_str);
+		std::uint16_t add_file(std::string_view a_file);
+		void          rebuild_index();
+
+		ankerl::unordered_dense::map<std::string, StringID>        _stringIndex;
+		ankerl::unordered_dense::map<std::string, std::uint16_t>   _fileIndex;
+		ankerl::unordered_dense::map<std::uint32_t, std::uint32_t> _rowIndex;
+	};
+}
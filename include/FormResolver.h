@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <ankerl/unordered_dense.h>
+
+#include "FormSwapParser.h"
+
+// Batch (plugin, localID) -> FormID resolution
+// Load order access goes through ILoadOrder so this can be benchmarked against a fake load order outside the game.
+namespace FormResolver
+{
+	class ILoadOrder
+	{
+	public:
+		virtual ~ILoadOrder() = default;
+
+		// FormID of localID 0 in this plugin (compile index, and small file index for light plugins)
+		[[nodiscard]] virtual std::optional<std::uint32_t> GetPluginPrefix(std::string_view a_plugin) const = 0;
+		// MergeMapper remapping, returns the input unchanged if the plugin wasn't merged
+		[[nodiscard]] virtual std::pair<std::string, std::uint32_t> Remap(std::string_view a_plugin, std::uint32_t a_localID) const = 0;
+		[[nodiscard]] virtual bool                                  HasRemapping() const = 0;
+		[[nodiscard]] virtual std::uint32_t                         LookupEditorID(std::string_view a_editorID) const = 0;
+	};
+
+	class Resolver
+	{
+	public:
+		explicit Resolver(const ILoadOrder& a_loadOrder) :
+			_loadOrder(a_loadOrder)
+		{}
+
+		// a_formIDs[i] is set to the FormID of a_refs[i], or 0 if it couldn't be resolved
+		void Resolve(std::span<const FormSwapParser::FormRef> a_refs, std::span<std::uint32_t> a_formIDs);
+
+	private:
+		struct Plugin
+		{
+			bool                         resolved{ false };
+			std::optional<std::uint32_t> prefix{};
+			// with remapping only, localID -> FormID, merges can take some forms of a plugin and leave the rest
+			ankerl::unordered_dense::map<std::uint32_t, std::uint32_t> remapped{};
+		};
+
+		static std::uint32_t get_formID(std::uint32_t a_prefix, std::uint32_t a_localID);
+
+		void                         resolve_plugin(std::string_view a_name, Plugin& a_plugin) const;
+		std::optional<std::uint32_t> get_merged_prefix(const std::string& a_plugin);
+
+		const ILoadOrder& _loadOrder;
+
+		// keys point into the parsed buffer, which must outlive the resolver
+		ankerl::unordered_dense::map<std::string_view, Plugin>                  _plugins;
+		ankerl::unordered_dense::map<std::string, std::optional<std::uint32_t>> _mergedPrefixes;
+	};
+
+	using FormPair = std::pair<std::uint32_t, std::uint32_t>;
+
+	// Resolves every entry of a parsed swap ini into a_runs[entry.section], needs a run per section the document was parsed with.
+	// Each run is sorted by base FormID and keeps the last entry for each base, same as insert_or_assign in file order.
+	void ResolveRuns(const FormSwapParser::Document& a_document, const ILoadOrder& a_loadOrder, std::span<std::vector<FormPair>> a_runs);
+}
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "HookStats.h"
 #include "SeasonManager.h"
 
 namespace FormSwap
@@ -24,7 +25,15 @@ namespace FormSwap
 			}
 
 			if (const auto base = a_ref->GetBaseObject()) {
+				HookStats::Scope stats(HookStats::HOOK::kGetHandle, a_ref->GetParentCell());
+
+				if (CallTrace::Recorder::GetSingleton().IsRecording()) {
+					const auto origBase = util::get_original_base(a_ref);
+					SeasonManager::GetSingleton()->RecordCall(CallTrace::HOOK::kGetHandle, a_ref->GetFormID(), origBase ? origBase->GetFormID() : base->GetFormID());
+				}
+
 				if (const auto replaceBase = detail::get_form_swap(a_ref, base)) {
+					stats.hit();
 					util::set_original_base(a_ref, base);
 					a_ref->SetObjectReference(replaceBase);
 				} else if (const auto origBase = util::get_original_base(a_ref); origBase && origBase != base) {
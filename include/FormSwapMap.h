@@ -1,5 +1,11 @@
 #pragma once
 
+#include "FormResolver.h"
+#include "FormSwapParser.h"
+#include "PerfectHash.h"
+#include "SeasonSwaps.h"
+#include "SwapGenerator.h"
+
 class FormSwapMap
 {
 public:
@@ -11,37 +17,38 @@ public:
 		kSwap
 	};
 
-	void LoadFormSwaps(const CSimpleIniA& a_ini);
-	void LoadFormSwaps(const std::string& a_type, const std::vector<std::string>& a_values);
+	using FormPair = std::pair<RE::FormID, RE::FormID>;
+	//resolved swaps from a single ini, one run per record type, sorted by base form (last entry wins)
+	using SwapRuns = std::array<std::vector<FormPair>, 8>;
+
+	//section names in SwapRuns order
+	static constexpr std::array<std::string_view, std::tuple_size_v<SwapRuns>>
+		recordTypeNames{ "LandTextures"sv, "Activators"sv, "Furniture"sv, "MovableStatics"sv, "Statics"sv, "Trees"sv, "Flora"sv, "VisualEffects"sv };
 
-	bool GenerateFormSwaps(CSimpleIniA& a_ini, bool a_forceRegenerate);
+	//document must be parsed with recordTypeNames as its section list
+	static SwapRuns ResolveFormSwaps(const FormSwapParser::Document& a_document);
+	void            MergeFormSwaps(const SwapRuns& a_runs);
 
-	RE::TESBoundObject* GetSwapForm(const RE::TESForm* a_form);
+	//moves the merged swaps out once every ini is loaded, lookups go through SeasonSwaps::Table after that
+	void ExtractFormSwaps(std::size_t a_season, std::vector<SeasonSwaps::Entry>& a_entries);
 
-	RE::TESLandTexture* GetSwapLandTexture(const RE::TESLandTexture* a_landTxst);
-	RE::TESLandTexture* GetSwapLandTexture(const RE::BGSTextureSet* a_txst);
+	//main WIN formswap, swapped in atomically so it can be installed from a worker thread while hooks are reading
+	//merged season inis take priority over it
+	void InstallMainSwaps(const SwapRuns& a_runs);
 
-	MapPair<RE::FormID>& get_map(RE::FormType a_formType)
+	enum class GENERATED : std::uint8_t
 	{
-		switch (a_formType) {
-		case RE::FormType::Activator:
-			return _formMap["Activators"];
-		case RE::FormType::Furniture:
-			return _formMap["Furniture"];
-		case RE::FormType::MovableStatic:
-			return _formMap["MovableStatics"];
-		case RE::FormType::Static:
-			return _formMap["Statics"];
-		case RE::FormType::Tree:
-			return _formMap["Trees"];
-		case RE::FormType::Flora:
-			return _formMap["Flora"];
-		case RE::FormType::ReferenceEffect:
-			return _formMap["VisualEffects"];
-		default:
-			return _nullMap;
-		}
-	}
+		kFailed = 0,
+		kUnchanged,
+		kWritten
+	};
+
+	//regenerates missing (or with a_forceRegenerate, changed) sections in place
+	static GENERATED GenerateFormSwaps(const std::filesystem::path& a_path, bool a_forceRegenerate);
+
+	//main swaps per record type, the ones that have been replaced are counted together
+	void GetMemoryStats(std::string_view a_season, std::vector<MemoryStats::Table>& a_tables);
+
 	MapPair<RE::FormID>& get_map(const std::string& a_section)
 	{
 		const auto it = _formMap.find(a_section);
@@ -51,155 +58,23 @@ public:
 private:
 	friend class SeasonManager;
 
-	template <class T>
-	using TempFormSwapMap = std::map<T*, T*>;
 	using RecordType = std::string;
+	//frozen when installed, the main WIN formswap doesn't change until the next install replaces it
+	using MainSwaps = std::array<PerfectHash::Map, std::tuple_size_v<SwapRuns>>;
 
 	static inline std::array<RecordType, 6>
 		standardTypes{ "LandTextures", "Activators", "Furniture", "MovableStatics", "Statics", "Trees" };
-	static inline std::array<RecordType, 8>
+	static inline std::array<RecordType, std::tuple_size_v<SwapRuns>>
 		recordTypes{ "LandTextures", "Activators", "Furniture", "MovableStatics", "Statics", "Trees", "Flora", "VisualEffects" };
 
-	static RE::TESLandTexture* GenerateLandTextureSnowVariant(const RE::TESLandTexture* a_landTexture);
-
-	template <class T>
-	void get_snow_variants_by_form(RE::TESDataHandler* a_dataHandler, TempFormSwapMap<T>& a_tempFormMap);
-	template <class T>
-	void get_snow_variants(CSimpleIniA& a_ini, const std::string& a_type, TempFormSwapMap<T>& a_tempFormMap);
+	static std::size_t get_index(RE::FormType a_formType);
+	RE::FormID         get_main_swap(std::size_t a_index, RE::FormID a_formID) const;
 
+	//merged season inis, only used while loading
 	Map<RecordType, MapPair<RE::FormID>> _formMap;
 	MapPair<RE::FormID>                  _nullMap{};
-};
-
-template <class T>
-void FormSwapMap::get_snow_variants_by_form(RE::TESDataHandler* a_dataHandler, TempFormSwapMap<T>& a_tempFormMap)
-{
-	auto& forms = a_dataHandler->GetFormArray(T::FORMTYPE);
-
-	static constexpr std::array blackList = { "Blacksmith"sv, "Frozen"sv, "Marker"sv };
-
-	std::map<std::string, T*> processedSnowForms;
-	for (auto& baseForm : forms) {
-		const auto form = skyrim_cast<T*>(baseForm);
-		if (form && model::only_contains_textureset(form, "Snow"sv)) {
-			std::string path = form->GetModel();
-			if (path.empty()) {
-				continue;
-			}
-			processedSnowForms.emplace(model::process_model_path(path), form);
-		}
-	}
 
-	for (auto& [path, snowForm] : processedSnowForms) {
-		for (auto& baseForm : forms) {
-			const auto form = skyrim_cast<T*>(baseForm);
-			if (form && string::icontains(form->model, path) && !model::contains_textureset(form, "Snow"sv) && !model::contains_textureset(form, "Frozen"sv)) {
-				if (std::ranges::any_of(blackList, [&](const auto& str) { return string::icontains(form->model, str); })) {
-					continue;
-				}
-				a_tempFormMap.emplace(form, snowForm);
-			}
-		}
-	}
-}
-
-template <class T>
-void FormSwapMap::get_snow_variants(CSimpleIniA& a_ini, const std::string& a_type, TempFormSwapMap<T>& a_tempFormMap)
-{
-	const auto dataHandler = RE::TESDataHandler::GetSingleton();
-
-	auto& formIDMap = get_map(a_type);
-
-	if constexpr (std::is_same_v<T, RE::TESLandTexture>) {
-		for (auto& landLT : dataHandler->GetFormArray<RE::TESLandTexture>()) {
-			if (const auto snowLT = GenerateLandTextureSnowVariant(landLT)) {
-				a_tempFormMap.emplace(landLT, snowLT);
-			}
-		}
-	} else if constexpr (std::is_same_v<T, RE::TESObjectSTAT>) {
-		static constexpr std::array snowBlackList = { "Ice"sv, "Icicle"sv, "Frozen"sv };
-		static constexpr std::array blackList = { "Ice"sv, "Icicle"sv, "Frozen"sv, "LoadScreen"sv, "INTERIOR"sv, "INV"sv, "DynDOLOD"sv };
-
-		std::map<std::string, RE::TESObjectSTAT*> processedSnowStats;
-
-		auto& statics = dataHandler->GetFormArray<RE::TESObjectSTAT>();
-
-		if (const auto snowOverSkyrim = dataHandler->LookupModByName("SnowOverSkyrim.esp")) {
-			for (auto& stat : statics) {
-				if (stat && snowOverSkyrim->IsFormInMod(stat->GetFormID())) {
-					std::string path = stat->GetModel();
-					if (path.empty()) {
-						continue;
-					}
-					processedSnowStats.emplace(model::process_model_path(path), stat);
-				}
-			}
-		}
-
-		constexpr auto is_in_blacklist = []<auto N>(const RE::TESObjectSTAT* a_stat, const std::array<std::string_view, N>& a_blacklist) {
-			const auto editorID = edid::get_editorID(a_stat);
-			return std::ranges::any_of(a_blacklist, [&](const auto& str) { return string::icontains(editorID, str); });
-		};
-
-		for (auto& stat : statics) {
-			const auto mat = stat->data.materialObj;
-			if (mat && util::is_snow_shader(mat) && model::only_contains_textureset(stat, { "Snow"sv, "Mask"sv }) || model::must_only_contain_textureset(stat, { "Snow", "Mask" })) {
-				std::string path = stat->GetModel();
-				if (path.empty() || is_in_blacklist(stat, snowBlackList)) {
-					continue;
-				}
-				processedSnowStats.emplace(model::process_model_path(path), stat);
-			}
-		}
-
-		for (auto& [snowPath, snowStat] : processedSnowStats) {
-			for (auto& stat : statics) {
-				std::string path = stat->GetModel();
-				string::replace_last_instance(path, "Moss"sv, ""sv);
-				if (string::icontains(path, snowPath) && snowStat != stat) {
-					if (const auto mat = stat->data.materialObj; !mat || !util::is_snow_shader(mat)) {
-						if (is_in_blacklist(stat, blackList)) {
-							continue;
-						}
-						a_tempFormMap.emplace(stat, snowStat);
-					}
-				}
-			}
-		}
-	} else if constexpr (std::is_same_v<T, RE::TESObjectTREE>) {
-		auto& trees = dataHandler->GetFormArray<RE::TESObjectTREE>();
-
-		std::map<std::string, RE::TESObjectTREE*> processedSnowTrees;
-		for (auto& tree : trees) {
-			if (std::string path = tree->GetModel(); string::icontains(path, "Snow")) {
-				string::replace_all(path, "Snow", "");
-				processedSnowTrees.emplace(path, tree);
-			}
-		}
-
-		for (auto& [path, snowTree] : processedSnowTrees) {
-			for (auto& tree : trees) {
-				if (string::icontains(tree->GetModel(), path) && tree != snowTree) {
-					a_tempFormMap.emplace(tree, snowTree);
-				}
-			}
-		}
-	} else {
-		get_snow_variants_by_form(dataHandler, a_tempFormMap);
-	}
-
-	for (auto& [form, swapForm] : a_tempFormMap) {
-		formIDMap.emplace(form->GetFormID(), swapForm->GetFormID());
-
-		//write values
-		auto formEID = edid::get_editorID(form);
-		auto swapEID = edid::get_editorID(swapForm);
-
-		std::string comment = std::format(";{}|{}", formEID, swapEID);
-		std::string value = std::format("0x{:X}~{}|0x{:X}~{}", form->GetLocalFormID(), form->GetFile(0)->fileName, swapForm->GetLocalFormID(), swapForm->GetFile(0)->fileName);
-
-		a_ini.SetValue(a_type.c_str(), "", value.c_str(), comment.c_str());
-	}
-
-	logger::info("	[{}] : wrote {} variants", a_type, formIDMap.size());
-}
+	std::atomic<const MainSwaps*>           _mainSwaps{ nullptr };
+	std::mutex                              _mainSwapsLock;
+	std::vector<std::unique_ptr<MainSwaps>> _mainSwapsStorage;  //installed tables are never freed, hooks may still be reading an older one
+};
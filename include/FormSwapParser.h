@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+#include <vector>
+
+// Allocation-free reader for form swap inis
+// Only depends on the standard library so it can be built and benchmarked outside the game.
+namespace FormSwapParser
+{
+	// 0x1234~Skyrim.esm, or an editorID
+	struct FormRef
+	{
+		std::string_view name{};  // plugin name, or editorID if isEditorID
+		std::uint32_t    localID{ 0 };
+		bool             isEditorID{ false };
+	};
+
+	// 0x1234~Skyrim.esm|0x5678~SnowOverSkyrim.esp
+	struct Entry
+	{
+		std::uint32_t section{ 0 };  // index into the section list passed to Parse
+		FormRef       base{};
+		FormRef       swap{};
+	};
+
+	// All views point into the parsed buffer, which must outlive the document
+	struct Document
+	{
+		void clear();
+
+		std::vector<Entry>            entries;      // file order
+		std::vector<std::uint32_t>    sectionSizes;  // entries per requested section
+		std::vector<std::string_view> worldspaces;  // keys under [Worldspaces]
+		std::size_t                   malformed{ 0 };
+	};
+
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		explicit MappedFile(const std::filesystem::path& a_path);
+		MappedFile(const MappedFile&) = delete;
+		MappedFile(MappedFile&&) = delete;
+		~MappedFile();
+
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile& operator=(MappedFile&&) = delete;
+
+		[[nodiscard]] bool             is_open() const { return _opened; }
+		[[nodiscard]] std::string_view data() const { return { _view, _size }; }
+
+	private:
+		const char* _view{ nullptr };
+		std::size_t _size{ 0 };
+		bool        _opened{ false };
+#ifdef _WIN32
+		void* _file{ nullptr };
+		void* _mapping{ nullptr };
+#endif
+	};
+
+	bool parse_hex(std::string_view a_str, std::uint32_t& a_value);
+	bool parse_form(std::string_view a_str, FormRef& a_ref);
+
+	// Collects every `base|swap` key under a_sections (matched case-insensitively, like CSimpleIni) into a_document.
+	// a_document's buffers are reused between calls.
+	void Parse(std::string_view a_data, std::span<const std::string_view> a_sections, Document& a_document);
+}
@@ -0,0 +1,140 @@
+#pragma once
+
+// Per-hook call counts, swap hit rate and latency histograms
+// Only recorded when built with HOOK_STATS (cmake -DHOOK_STATS=ON), otherwise Scope is empty and compiles away.
+namespace HookStats
+{
+	enum class HOOK : std::uint32_t
+	{
+		kGetHandle = 0,
+		kStaticsClone3D,
+		kOtherFormsClone3D,
+		kIsConsideredSnow,
+		kGetSpecularComponent,
+		kGetAsShaderTextureSet,
+		kGetGrassList,
+		kGetHavokMaterialType,
+		kTerrainMeshFileName,
+		kTerrainDiffuseTextureFileName,
+		kTerrainNormalTextureFileName,
+		kObjectMeshFileName,
+		kObjectDiffuseTextureAtlasFileName,
+		kObjectNormalTextureAtlasFileName,
+		kTreeMeshFileName,
+		kTreeTextureFileName,
+		kTreeTypeListFileName,
+
+		kTotal
+	};
+
+	inline constexpr std::array<std::string_view, std::to_underlying(HOOK::kTotal)> hookNames{
+		"FormSwap::GetHandle"sv,
+		"Statics::Clone3D"sv,
+		"OtherForms::Clone3D"sv,
+		"Texture::IsConsideredSnow"sv,
+		"Texture::GetSpecularComponent"sv,
+		"Texture::GetAsShaderTextureSet"sv,
+		"Grass::GetGrassList"sv,
+		"Material::GetHavokMaterialType"sv,
+		"LOD::Terrain::Mesh"sv,
+		"LOD::Terrain::DiffuseTexture"sv,
+		"LOD::Terrain::NormalTexture"sv,
+		"LOD::Object::Mesh"sv,
+		"LOD::Object::DiffuseAtlas"sv,
+		"LOD::Object::NormalAtlas"sv,
+		"LOD::Tree::Mesh"sv,
+		"LOD::Tree::Texture"sv,
+		"LOD::Tree::TypeList"sv
+	};
+
+	// landscape hooks only see the texture, so their cost goes to the player's cell, where the hitch is felt
+	struct player_cell_t
+	{};
+	inline constexpr player_cell_t playerCell{};
+
+#ifdef HOOK_STATS
+	inline constexpr bool enabled = true;
+
+	// times the enclosing hook call, a hit is a call that swapped something
+	// scopes given a cell also charge their time and work to it
+	class Scope
+	{
+	public:
+		explicit Scope(HOOK a_hook) :
+			_hook(a_hook),
+			_start(std::chrono::steady_clock::now())
+		{}
+		Scope(HOOK a_hook, const RE::TESObjectCELL* a_cell) :
+			_hook(a_hook),
+			_start(std::chrono::steady_clock::now()),
+			_cell(a_cell ? a_cell->GetFormID() : 0),
+			_charged(true)
+		{}
+		Scope(HOOK a_hook, player_cell_t);
+		Scope(const Scope&) = delete;
+		Scope(Scope&&) = delete;
+		~Scope();
+
+		Scope& operator=(const Scope&) = delete;
+		Scope& operator=(Scope&&) = delete;
+
+		void hit() { _hit = true; }
+		// the static was cloned again after a throwaway clone to classify it
+		void double_clone() { _doubleClone = true; }
+
+	private:
+		HOOK                                  _hook;
+		std::chrono::steady_clock::time_point _start;
+		RE::FormID                            _cell{ 0 };
+		bool                                  _charged{ false };
+		bool                                  _hit{ false };
+		bool                                  _doubleClone{ false };
+	};
+#else
+	inline constexpr bool enabled = false;
+
+	class Scope
+	{
+	public:
+		explicit Scope(HOOK) {}
+		Scope(HOOK, const RE::TESObjectCELL*) {}
+		Scope(HOOK, player_cell_t) {}
+
+		void hit() {}
+		void double_clone() {}
+	};
+#endif
+
+	struct Summary
+	{
+		std::string_view name{};
+		std::uint64_t    calls{ 0 };
+		std::uint64_t    hits{ 0 };
+		std::uint64_t    p50{ 0 };  // ns, upper bound of the histogram bucket
+		std::uint64_t    p99{ 0 };
+		std::uint64_t    total{ 0 };  // ns
+	};
+
+	// merged across threads, hooks that were never called are skipped
+	std::vector<Summary> GetSummary();
+	void                 Reset();
+
+	// one line per hook, for the console and the log
+	std::vector<std::string> GetReport();
+
+	struct CellCost
+	{
+		RE::FormID    cell{ 0 };  // 0 if the reference had no parent cell
+		std::uint64_t total{ 0 };  // ns
+		std::uint64_t error{ 0 };  // ns, total may be overcounted by up to this much if the cell replaced an evicted one
+		std::uint64_t swaps{ 0 };
+		std::uint64_t classifications{ 0 };  // Clone3D snow shader decisions
+		std::uint64_t doubleClones{ 0 };
+		std::uint64_t landLookups{ 0 };
+	};
+
+	// most expensive cells first, out of the most expensive few hundred seen
+	// each thread merges its charges every few hundred calls or 100 ms, so the latest ones may not show up yet
+	std::vector<CellCost>    GetWorstCells(std::size_t a_count);
+	std::vector<std::string> GetCellReport(std::size_t a_count);
+}
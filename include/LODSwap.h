@@ -2,6 +2,8 @@
 
 #include <Seasons.h>
 
+#include "HookStats.h"
+
 namespace LODSwap
 {
 	struct detail
@@ -9,7 +11,12 @@ namespace LODSwap
 		template <class T>
 		static std::string get_lod_filename()
 		{
+			HookStats::Scope stats(T::hook);
+
 			const auto [canSwap, season] = SeasonManager::GetSingleton()->CanSwapLOD(T::type);
+			if (canSwap) {
+				stats.hit();
+			}
 			return canSwap ? std::format(T::seasonalPath, season) : std::string(T::defaultPath);
 		}
 	};
@@ -31,6 +38,7 @@ namespace LODSwap
 			static inline constexpr std::string_view defaultPath{ R"(Data\Meshes\Terrain\%s\%s.%i.%i.%i.BTR)" };
 
 			static inline auto type = LOD_TYPE::kTerrain;
+			static inline auto hook = HookStats::HOOK::kTerrainMeshFileName;
 		};
 
 		struct BuildDiffuseTextureFileName
@@ -48,6 +56,7 @@ namespace LODSwap
 			static inline constexpr std::string_view defaultPath{ R"(Data\Textures\Terrain\%s\%s.%i.%i.%i.DDS)" };
 
 			static inline auto type = LOD_TYPE::kTerrain;
+			static inline auto hook = HookStats::HOOK::kTerrainDiffuseTextureFileName;
 		};
 
 		struct BuildNormalTextureFileName
@@ -65,6 +74,7 @@ namespace LODSwap
 			static inline constexpr std::string_view defaultPath{ R"(Data\Textures\Terrain\%s\%s.%i.%i.%i_n.DDS)" };
 
 			static inline auto type = LOD_TYPE::kTerrain;
+			static inline auto hook = HookStats::HOOK::kTerrainNormalTextureFileName;
 		};
 
 		inline void Install()
@@ -92,6 +102,7 @@ namespace LODSwap
 			static inline constexpr std::string_view defaultPath{ R"(Data\Meshes\Terrain\%s\Objects\%s.%i.%i.%i.BTO)" };
 
 			static inline auto type = LOD_TYPE::kObject;
+			static inline auto hook = HookStats::HOOK::kObjectMeshFileName;
 		};
 
 		struct BuildDiffuseTextureAtlasFileName
@@ -109,6 +120,7 @@ namespace LODSwap
 			static inline constexpr std::string_view defaultPath{ R"(Data\Textures\Terrain\%s\Objects\%s.Objects.DDS)" };
 
 			static inline auto type = LOD_TYPE::kObject;
+			static inline auto hook = HookStats::HOOK::kObjectDiffuseTextureAtlasFileName;
 		};
 
 		struct BuildNormalTextureAtlasFileName
@@ -126,6 +138,7 @@ namespace LODSwap
 			static inline constexpr std::string_view defaultPath{ R"(Data\Textures\Terrain\%s\Objects\%s.Objects_n.DDS)" };
 
 			static inline auto type = LOD_TYPE::kObject;
+			static inline auto hook = HookStats::HOOK::kObjectNormalTextureAtlasFileName;
 		};
 
 		inline void Install()
@@ -153,6 +166,7 @@ namespace LODSwap
 			static inline constexpr std::string_view defaultPath{ R"(Data\Meshes\Terrain\%s\Trees\%s.%i.%i.%i.BTT)" };
 
 			static inline auto type = LOD_TYPE::kTree;
+			static inline auto hook = HookStats::HOOK::kTreeMeshFileName;
 		};
 
 		struct BuildTextureFileName
@@ -170,6 +184,7 @@ namespace LODSwap
 			static inline constexpr std::string_view defaultPath{ R"(Data\Textures\Terrain\%s\Trees\%sTreeLOD.DDS)" };
 
 			static inline auto type = LOD_TYPE::kTree;
+			static inline auto hook = HookStats::HOOK::kTreeTextureFileName;
 		};
 
 		struct BuildTypeListFileName
@@ -187,6 +202,7 @@ namespace LODSwap
 			static inline constexpr std::string_view defaultPath{ R"(Data\Meshes\Terrain\%s\Trees\%s.LST)" };
 
 			static inline auto type = LOD_TYPE::kTree;
+			static inline auto hook = HookStats::HOOK::kTreeTypeListFileName;
 		};
 
 		inline void Install()
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "HookStats.h"
 #include "SeasonManager.h"
 
 namespace LandscapeSwap
@@ -12,9 +13,17 @@ namespace LandscapeSwap
 		{
 			static float thunk(const RE::TESLandTexture* a_LT)
 			{
+				HookStats::Scope stats(HookStats::HOOK::kIsConsideredSnow, HookStats::playerCell);
+
 				const auto manager = SeasonManager::GetSingleton();
+				if (CallTrace::Recorder::GetSingleton().IsRecording()) {
+					manager->RecordCall(CallTrace::HOOK::kIsConsideredSnow, a_LT->GetFormID());
+				}
 
 				const auto swapLT = manager->CanSwapLandscape() ? manager->GetSwapLandTexture(a_LT) : a_LT;
+				if (swapLT && swapLT != a_LT) {
+					stats.hit();
+				}
 				return swapLT ? swapLT->shaderTextureIndex != 0 : a_LT->shaderTextureIndex != 0;
 			}
 			static inline REL::Relocation<decltype(thunk)> func;
@@ -36,9 +45,17 @@ namespace LandscapeSwap
 		{
 			static float thunk(const RE::TESLandTexture* a_LT)
 			{
+				HookStats::Scope stats(HookStats::HOOK::kGetSpecularComponent, HookStats::playerCell);
+
 				const auto manager = SeasonManager::GetSingleton();
+				if (CallTrace::Recorder::GetSingleton().IsRecording()) {
+					manager->RecordCall(CallTrace::HOOK::kGetSpecularComponent, a_LT->GetFormID());
+				}
 
 				const auto swapLT = manager->CanSwapLandscape() ? manager->GetSwapLandTexture(a_LT) : nullptr;
+				if (swapLT) {
+					stats.hit();
+				}
 				return swapLT ? swapLT->specularExponent : a_LT->specularExponent;
 			}
 			static inline REL::Relocation<decltype(thunk)> func;
@@ -59,7 +76,12 @@ namespace LandscapeSwap
 		{
 			static RE::BSTextureSet* thunk(RE::BGSTextureSet* a_txst)
 			{
+				HookStats::Scope stats(HookStats::HOOK::kGetAsShaderTextureSet, HookStats::playerCell);
+
 				const auto manager = SeasonManager::GetSingleton();
+				if (CallTrace::Recorder::GetSingleton().IsRecording()) {
+					manager->RecordCall(CallTrace::HOOK::kGetAsShaderTextureSet, a_txst ? a_txst->GetFormID() : 0);
+				}
 
 				const auto swapLT = manager->CanSwapLandscape() ? manager->GetSwapLandTexture(a_txst) : nullptr;
 				if (swapLT == nullptr) {
@@ -70,6 +92,8 @@ namespace LandscapeSwap
 					return a_txst;
 				}
 
+				stats.hit();
+
 				const auto swapTXST = swapLT->textureSet;
 				if (a_txst != nullptr && swapTXST != nullptr) {
 					a_txst->pad12C = swapTXST->formID;  // Set pad12C to swapped TXST formid
@@ -105,9 +129,13 @@ namespace LandscapeSwap
 		{
 			static RE::BSSimpleList<RE::TESGrass*>& func(RE::TESLandTexture* a_landTexture)
 			{
+				HookStats::Scope stats(HookStats::HOOK::kGetGrassList, HookStats::playerCell);
+
 				if (const auto seasonManager = SeasonManager::GetSingleton(); seasonManager->CanSwapGrass()) {
 					const auto swapLandTexture = seasonManager->GetSwapLandTexture(a_landTexture);
-
+					if (swapLandTexture) {
+						stats.hit();
+					}
 					return swapLandTexture ? swapLandTexture->textureGrassList : a_landTexture->textureGrassList;
 				}
 				return a_landTexture->textureGrassList;
@@ -129,8 +157,13 @@ namespace LandscapeSwap
 		{
 			static RE::MATERIAL_ID func(const RE::TESLandTexture* a_landTexture)
 			{
+				HookStats::Scope stats(HookStats::HOOK::kGetHavokMaterialType, HookStats::playerCell);
+
 				if (const auto seasonManager = SeasonManager::GetSingleton(); seasonManager->CanSwapLandscape()) {
 					const auto newLandTexture = seasonManager->GetSwapLandTexture(a_landTexture);
+					if (newLandTexture) {
+						stats.hit();
+					}
 					const auto materialType = newLandTexture ? newLandTexture->materialType : a_landTexture->materialType;
 
 					return materialType ? materialType->materialID : RE::MATERIAL_ID::kNone;
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "Seasons.h"
+
+namespace Manifest
+{
+	enum class FILE_TYPE : std::uint32_t
+	{
+		kSeasonSwap = 0,  // *_WIN.ini, *_SPR.ini, *_SUM.ini, *_AUT.ini
+		kSnowConfig,      // *_SNOW.ini, *_NOSNOW.ini
+		kMainSwap         // MainFormSwap_WIN.ini
+	};
+
+	struct Entry
+	{
+		std::filesystem::path path{};
+		FILE_TYPE             type{};
+		SEASON                season{ SEASON::kNone };
+		std::uintmax_t        size{ 0 };  // 0 if it couldn't be read, an empty main WIN formswap is regenerated
+	};
+
+	// Single scan of Data/Seasons, shared by every config loader
+	class Manager : public REX::Singleton<Manager>
+	{
+	public:
+		void Scan();
+
+		[[nodiscard]] std::vector<const Entry*> GetFiles(FILE_TYPE a_type) const;
+		[[nodiscard]] const Entry*              GetMainSwap() const;
+
+	private:
+		static std::optional<std::pair<FILE_TYPE, SEASON>> get_file_type(std::string_view a_stem);
+
+		std::vector<Entry> _entries{};  // sorted by path
+	};
+}
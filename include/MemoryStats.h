@@ -0,0 +1,37 @@
+#pragma once
+
+#include "PerfectHash.h"
+
+// Entries, bucket capacity and approximate bytes of the lookup tables the plugin keeps for the whole session
+// Logged at kDataLoaded and on every season change, and printed by GetSeasonsMemoryStats (GSMS), so growth shows up in long sessions.
+namespace MemoryStats
+{
+	struct Table
+	{
+		std::string name;
+		std::size_t entries{ 0 };
+		std::size_t capacity{ 0 };  // allocated value slots
+		std::size_t buckets{ 0 };
+		std::size_t bytes{ 0 };  // values and buckets, not counting heap owned by the values themselves
+	};
+
+	// ankerl::unordered_dense map or set, values are stored in a separate vector from the buckets
+	template <class T>
+	Table GetTable(std::string a_name, const T& a_table)
+	{
+		const auto capacity = a_table.values().capacity();
+		const auto buckets = a_table.bucket_count();
+		return { std::move(a_name), a_table.size(), capacity, buckets, capacity * sizeof(typename T::value_type) + buckets * sizeof(typename T::bucket_type) };
+	}
+
+	// PerfectHash::Map, key/value slots and one pilot per bucket
+	inline Table GetTable(std::string a_name, const PerfectHash::Map& a_table)
+	{
+		return { std::move(a_name), a_table.size(), a_table.slot_count(), a_table.bucket_count(), a_table.get_memory_usage() };
+	}
+
+	std::vector<Table> Collect();
+
+	std::vector<std::string> GetReport();
+	void                     Log(std::string_view a_reason);
+}
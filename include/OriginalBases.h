@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+#include <shared_mutex>
+
+#include <ankerl/unordered_dense.h>
+
+// Original base object of every attached reference that GetHandle swapped, keyed by reference FormID
+// Entries are added when a reference is swapped and released when it detaches, so the table follows the loaded area.
+// Only depends on the standard library so long travel can be simulated outside the game (tools/Benchmark soak driver).
+namespace OriginalBases
+{
+	class Tracker
+	{
+	public:
+		// 0 if a_ref isn't tracked
+		[[nodiscard]] std::uint32_t Get(std::uint32_t a_ref) const;
+		// keeps the first base, a reference swapped again is already tracked with its original one
+		void Set(std::uint32_t a_ref, std::uint32_t a_base);
+		// stops tracking a_ref, returns its original base or 0
+		std::uint32_t Release(std::uint32_t a_ref);
+
+		[[nodiscard]] std::size_t size() const;
+		[[nodiscard]] std::size_t capacity() const;
+		[[nodiscard]] std::size_t bucket_count() const;
+		// values and buckets
+		[[nodiscard]] std::size_t get_memory_usage() const;
+
+	private:
+		using Lock = std::shared_mutex;
+		using Map = ankerl::unordered_dense::map<std::uint32_t, std::uint32_t>;
+
+		mutable Lock _lock;
+		Map          _originals;
+	};
+}
@@ -2,8 +2,16 @@
 
 #define WIN32_LEAN_AND_MEAN
 
+#include <atomic>
+#include <charconv>
+#include <condition_variable>
+#include <execution>
+#include <fstream>
+#include <functional>
+#include <future>
 #include <ranges>
 #include <shared_mutex>
+#include <thread>
 
 #include "RE/Skyrim.h"
 #include "SKSE/SKSE.h"
@@ -84,6 +92,10 @@ using Set = ankerl::unordered_dense::set<T>;
 #	define OFFSET_3(se, ae, vr) se
 #endif
 
+#include "FormCatalog.h"
+#include "MemoryStats.h"
+#include "OriginalBases.h"
+#include "StringSearch.h"
 #include "Cache.h"
 #include "Util.h"
 #include "Version.h"
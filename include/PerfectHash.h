@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Static FormID -> FormID map, built once from a fixed set of keys
+// Hash and displace: every bucket of ~4 keys stores the pilot that sent its keys to free slots,
+// so a lookup reads one pilot and probes exactly one slot of a flat key/value array.
+// Only depends on the standard library so it can be benchmarked outside the game.
+namespace PerfectHash
+{
+	class Map
+	{
+	public:
+		using value_type = std::pair<std::uint32_t, std::uint32_t>;
+
+		// keys must be non-zero, replaces the previous contents
+		// false if no seed placed every key (only duplicate keys do that), lookups then binary search the pairs sorted by key
+		bool Build(std::span<const value_type> a_pairs);
+
+		// 0 if a_key isn't in the map
+		[[nodiscard]] std::uint32_t find(std::uint32_t a_key) const
+		{
+			if (_slots.empty()) {
+				return 0;
+			}
+			if (_pilots.empty()) {
+				return find_sorted(a_key);
+			}
+
+			const auto hash = mix(a_key ^ _seed);
+			const auto pilot = _pilots[reduce(hash >> 32, _pilots.size())];
+			const auto& [key, value] = _slots[get_slot(hash, pilot)];
+			return key == a_key ? value : 0;
+		}
+
+		[[nodiscard]] bool        empty() const { return _size == 0; }
+		[[nodiscard]] std::size_t size() const { return _size; }
+		[[nodiscard]] std::size_t slot_count() const { return _slots.size(); }
+		[[nodiscard]] std::size_t bucket_count() const { return _pilots.size(); }
+		[[nodiscard]] std::size_t get_memory_usage() const { return _slots.capacity() * sizeof(value_type) + _pilots.capacity() * sizeof(std::uint16_t); }
+
+	private:
+		// splitmix64 finalizer
+		static constexpr std::uint64_t mix(std::uint64_t a_value)
+		{
+			a_value ^= a_value >> 30;
+			a_value *= 0xBF58476D1CE4E5B9;
+			a_value ^= a_value >> 27;
+			a_value *= 0x94D049BB133111EB;
+			return a_value ^ (a_value >> 31);
+		}
+
+		// maps a 32 bit hash to [0, a_range) without a division
+		static constexpr std::size_t reduce(std::uint64_t a_hash, std::size_t a_range)
+		{
+			return static_cast<std::size_t>(((a_hash & 0xFFFFFFFF) * a_range) >> 32);
+		}
+
+		[[nodiscard]] std::size_t get_slot(std::uint64_t a_hash, std::uint16_t a_pilot) const
+		{
+			return reduce(mix(a_hash ^ a_pilot), _slots.size());
+		}
+
+		[[nodiscard]] std::uint32_t find_sorted(std::uint32_t a_key) const;
+
+		std::uint64_t              _seed{ 0 };
+		std::size_t                _size{ 0 };
+		std::vector<std::uint16_t> _pilots;  // empty if the build fell back to sorted pairs
+		std::vector<value_type>    _slots;   // empty slots have key 0
+	};
+}
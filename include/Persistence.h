@@ -0,0 +1,57 @@
+#pragma once
+
+namespace Persistence
+{
+	// Write-behind store for every INI the plugin writes.
+	// Documents are serialized on the calling thread and written out by a worker using temp file + rename.
+	// Writes are skipped if the serialized bytes match what is already on disk.
+	// Nothing is written during process teardown, so Flush has to be called at every point the game may exit after.
+	class Manager : public REX::Singleton<Manager>
+	{
+	public:
+		~Manager();
+
+		// loads the latest queued version of the document if one exists, otherwise reads it from disk
+		SI_Error LoadFile(CSimpleIniA& a_ini, const std::filesystem::path& a_path);
+		void     SaveFile(const CSimpleIniA& a_ini, const std::filesystem::path& a_path);
+
+		// writes every queued document on the calling thread
+		void Flush();
+
+		// writes a file too large to queue as a document, on the calling thread, using temp file + rename
+		// a_write streams the contents, the temp file is removed if writing or replacing fails
+		bool WriteFile(const std::filesystem::path& a_path, const std::function<bool(std::ostream&)>& a_write);
+
+	private:
+		using Lock = std::mutex;
+		using Locker = std::unique_lock<Lock>;
+		using Key = std::filesystem::path::string_type;
+
+		struct Document
+		{
+			std::filesystem::path path;
+			std::string           data;
+		};
+
+		void Start();
+		void Run();
+		void WriteDirty();
+
+		std::vector<Document> TakeDirty();
+		void                  WriteDocuments(const std::vector<Document>& a_documents);
+		bool                  WriteDocument(const Document& a_document);  // true if a_document is on disk, written now or already there
+
+		static std::uint64_t GetHash(std::string_view a_data);
+
+		Lock                    _lock;
+		Lock                    _writeLock;  // held by whichever of the worker and Flush is writing, so an older document can't land last
+		std::condition_variable _pendingCV;
+
+		Map<Key, std::string>   _latest;      // queued or in-flight contents, served back to LoadFile
+		Set<Key>                _dirty;       // queued but not yet written
+		Set<Key>                _failed;      // write failed, retried by the next Flush or worker write
+		Map<Key, std::uint64_t> _diskHashes;  // hash of what is on disk (guarded by _writeLock)
+
+		std::thread _worker;
+	};
+}
@@ -1,12 +1,21 @@
 #pragma once
 
+#include "CallTrace.h"
+#include "Manifest.h"
 #include "Seasons.h"
+#include "Trace.h"
 
 class SeasonManager final :
 	public REX::Singleton<SeasonManager>,
-	public RE::BSTEventSink<RE::TESActivateEvent>
+	public RE::BSTEventSink<RE::TESActivateEvent>,
+	public RE::BSTEventSink<RE::TESCellAttachDetachEvent>
 {
 public:
+	enum : std::uint32_t
+	{
+		kSeasonState = 'SOSS'
+	};
+
 	static void InstallHooks()
 	{
 		Hooks::Install();
@@ -19,19 +28,28 @@ public:
 		if (const auto scripts = RE::ScriptEventSourceHolder::GetSingleton()) {
 			scripts->AddEventSink<RE::TESActivateEvent>(this);
 			logger::info("Registered {}"sv, typeid(RE::TESActivateEvent).name());
+
+			scripts->AddEventSink<RE::TESCellAttachDetachEvent>(this);
+			logger::info("Registered {}"sv, typeid(RE::TESCellAttachDetachEvent).name());
 		}
 	}
 
 	void LoadSettings();
 	void LoadOrGenerateWinterFormSwap();
+	//blocks until background generation (if any) has installed the main WIN formswap
+	void WaitForWinterFormSwap();
 	void LoadSeasonData();
 	void CheckLODExists();
 
 	//Calendar is not initialized using savegame values when it is loaded from start
+	void Save(SKSE::SerializationInterface* a_intfc, std::uint32_t a_version);
+	void Load(SKSE::SerializationInterface* a_intfc);
+
+	//pre-cosave saves are tracked in Serialization.ini, and migrated to the cosave on next save
 	void SaveSeason(std::string_view a_savePath);
 	void LoadSeason(const std::string& a_savePath);
-	void ClearSeason(std::string_view a_savePath) const;
-	void CleanupSerializedSeasonList() const;
+	void ClearSeason(std::string_view a_savePath);
+	void CleanupSerializedSeasonList();
 
 	bool UpdateSeason();
 
@@ -52,6 +70,12 @@ public:
 	RE::TESLandTexture* GetSwapLandTexture(const RE::TESLandTexture* a_landTxst);
 	RE::TESLandTexture* GetSwapLandTexture(const RE::BGSTextureSet* a_txst);
 
+	//tags a hook call with the current season and worldspace, only call while CallTrace::Recorder is recording
+	void RecordCall(CallTrace::HOOK a_hook, RE::FormID a_form, RE::FormID a_base = 0);
+
+	//formswap tables of every season, and the combined season ini table
+	void GetMemoryStats(std::vector<MemoryStats::Table>& a_tables);
+
 	[[nodiscard]] bool GetExterior();
 	void               SetExterior(bool a_isExterior);
 
@@ -70,9 +94,18 @@ protected:
 
 	void LoadMonthToSeasonMap(CSimpleIniA& a_ini);
 
-	static void LoadSeasonData(Season& a_season, CSimpleIniA& a_settings);
+	//merged season inis first, then the main WIN formswap of a_season
+	RE::FormID GetSwapFormID(Season* a_season, RE::FormType a_formType, RE::FormID a_formID) const;
+
+	static void LoadSeasonData(Season& a_season, const std::vector<const Manifest::Entry*>& a_configs, std::vector<std::optional<Season::ConfigData>>& a_configData, CSimpleIniA& a_settings);
 
-	bool ShouldRegenerateWinterFormSwap() const;
+	//mod count to store once regeneration has finished, nullopt if the main WIN formswap is current
+	std::optional<std::size_t> ShouldRegenerateWinterFormSwap() const;
+	void                       SaveWinterFormSwapModCount(std::size_t a_modCount) const;
+	bool IsWinterFormSwapSkipped(std::string_view a_type) const;
+
+	void SaveLegacySeasonList() const;
+	void WaitForSerializedSeasonList();
 
 	struct Hooks
 	{
@@ -86,7 +119,10 @@ protected:
 				manager->SetExterior(!a_isInterior);
 
 				if (!a_isInterior) {
-					manager->UpdateSeason();
+					manager->WaitForWinterFormSwap();
+					if (manager->UpdateSeason()) {
+						Trace::Write();
+					}
 				}
 			}
 			static inline REL::Relocation<decltype(thunk)> func;
@@ -105,6 +141,7 @@ protected:
 	};
 
 	EventResult ProcessEvent(const RE::TESActivateEvent* a_event, RE::BSTEventSource<RE::TESActivateEvent>*) override;
+	EventResult ProcessEvent(const RE::TESCellAttachDetachEvent* a_event, RE::BSTEventSource<RE::TESCellAttachDetachEvent>*) override;
 
 private:
 	SEASON_TYPE seasonType{ SEASON_TYPE::kSeasonal };
@@ -144,6 +181,9 @@ private:
 	Season summer{ SEASON::kSummer, { "Summer", "SUM" } };
 	Season autumn{ SEASON::kAutumn, { "Autumn", "AUT" } };
 
+	//season inis of all four seasons, built once LoadSeasonData is done and read-only after that
+	SeasonSwaps::Table seasonSwaps{};
+
 	SEASON currentSeason{ SEASON::kNone };
 	SEASON lastSeason{ SEASON::kNone };
 
@@ -155,9 +195,24 @@ private:
 
 	bool loadedFromSave{ false };
 
+	struct LegacySeasonList
+	{
+		//save name, current season|season override
+		Map<std::string, std::pair<SEASON, SEASON>> saves{};
+		std::size_t                                 pruned{ 0 };
+		std::size_t                                 malformed{ 0 };
+	};
+
+	LegacySeasonList ReadSerializedSeasonList(const std::optional<std::filesystem::path>& a_directory) const;
+
+	Map<std::string, std::pair<SEASON, SEASON>> legacySeasons{};
+	std::future<LegacySeasonList>               legacySeasonsTask{};
+
 	struct
 	{
 		bool skip{ false };
+		bool generate{ true };
+		bool exportCatalog{ false };
 
 		bool skipLT{ false };
 		bool skipActi{ false };
@@ -168,8 +223,12 @@ private:
 
 	} mainWINSwap;
 
+	std::future<void> mainSwapTask{};
+
 	const wchar_t* settings{ L"Data/SKSE/Plugins/po3_SeasonsOfSkyrim.ini" };
 	const wchar_t* serializedSeasonList{ L"Data/Seasons/Serialization.ini" };
+	//mod count is saved from the generation worker, the save list from the main thread
+	mutable std::mutex serializedSeasonListLock;
 };
 
 template <class T>
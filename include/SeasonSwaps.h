@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#if defined(_M_X64) || defined(__x86_64__)
+#	include <xmmintrin.h>
+#endif
+
+// Merged season ini swaps of all four seasons in one table, keyed by base FormID
+// Each row holds the swap target of every season, so a season change reads the same rows instead of a cold table.
+// Only depends on the standard library so it can be benchmarked outside the game.
+namespace SeasonSwaps
+{
+	// winter, spring, summer, autumn (SEASON - 1)
+	inline constexpr std::size_t seasonCount = 4;
+	// FormSwapMap::recordTypeNames order
+	inline constexpr std::size_t typeCount = 8;
+
+	struct Entry
+	{
+		std::uint32_t base;
+		std::uint32_t swap;
+		std::uint8_t  type;
+		std::uint8_t  season;
+	};
+
+	// swap FormID per season, 0 if the base isn't swapped in that season
+	using Row = std::array<std::uint32_t, seasonCount>;
+
+	class Table
+	{
+	public:
+		// later entries for the same type, season and base override earlier ones
+		void Build(std::span<const Entry> a_entries);
+
+		// 0 if a_base has no swap in a_season
+		[[nodiscard]] std::uint32_t find(std::size_t a_type, std::size_t a_season, std::uint32_t a_base) const
+		{
+			if (a_type >= typeCount) {
+				return 0;
+			}
+
+			// Eytzinger search, 1-based so the children of k are 2k and 2k + 1
+			const auto [offset, size] = _index[a_type];
+			const auto keys = _keys.data() + offset;
+
+			std::size_t k = 1;
+			while (k <= size) {
+#if defined(_M_X64) || defined(__x86_64__)
+				// 16 keys per cache line, so this fetches the node four levels down while the current one is compared
+				_mm_prefetch(reinterpret_cast<const char*>(keys + 16 * k), _MM_HINT_T0);
+#endif
+				k = 2 * k + (keys[k] < a_base);
+			}
+			// undo the right turns taken after the last left turn, that node is the lower bound
+			k >>= std::countr_one(k) + 1;
+
+			return k != 0 && keys[k] == a_base ? _rows[offset + k][a_season] : 0;
+		}
+
+		[[nodiscard]] bool        empty() const { return _keys.empty(); }
+		[[nodiscard]] std::size_t size() const;
+		[[nodiscard]] std::size_t size(std::size_t a_type) const { return _index[a_type].size; }
+
+		// keys and rows of a_type, including the unused first slot
+		[[nodiscard]] std::size_t get_memory_usage(std::size_t a_type) const;
+
+	private:
+		struct Range
+		{
+			std::uint32_t offset{ 0 };  // unused slot before the first key
+			std::uint32_t size{ 0 };
+		};
+
+		// per record type, in Eytzinger order
+		std::array<Range, typeCount> _index{};
+		std::vector<std::uint32_t>   _keys;
+		std::vector<Row>             _rows;  // same order as _keys
+	};
+}
@@ -54,8 +54,19 @@ public:
 	[[nodiscard]] const SEASON_ID& GetID() const;
 	[[nodiscard]] SEASON           GetType() const;
 
+	//parsed and resolved contents of a single season ini
+	struct ConfigData
+	{
+		FormSwapMap::SwapRuns    swaps{};
+		std::vector<std::string> worldspaces{};
+		std::size_t              malformed{ 0 };
+	};
+
+	//thread-safe, does not touch season state
+	static std::optional<ConfigData> ParseConfig(const std::filesystem::path& a_path);
+
 	[[nodiscard]] FormSwapMap& GetFormSwapMap();
-	void                       LoadData(const CSimpleIniA& a_ini);
+	void                       LoadData(const ConfigData& a_data);
 	void                       SaveData(CSimpleIniA& a_ini);
 
 private:
@@ -0,0 +1,17 @@
+#pragma once
+
+namespace Serialization
+{
+	enum : std::uint32_t
+	{
+		kSerializationVersion = 1,
+
+		kSeasons = 'SOSK'
+	};
+
+	std::string DecodeTypeCode(std::uint32_t a_typeCode);
+
+	void SaveCallback(SKSE::SerializationInterface* a_intfc);
+	void LoadCallback(SKSE::SerializationInterface* a_intfc);
+	void RevertCallback(SKSE::SerializationInterface* a_intfc);
+}
@@ -1,5 +1,8 @@
 #pragma once
 
+#include "HookStats.h"
+#include "SeasonManager.h"
+
 namespace SnowSwap
 {
 	enum class SNOW_TYPE
@@ -55,6 +58,8 @@ namespace SnowSwap
 		[[nodiscard]] RE::BGSMaterialObject* GetMultiPassSnowShader();
 		[[nodiscard]] RE::BGSMaterialObject* GetSinglePassSnowShader();
 
+		void GetMemoryStats(std::vector<MemoryStats::Table>& a_tables) const;
+
 	private:
 		using Lock = std::shared_mutex;
 		using Locker = std::scoped_lock<Lock>;
@@ -83,8 +88,15 @@ namespace SnowSwap
 	{
 		struct Clone3D
 		{
+			//timing includes the original Clone3D, and the extra one made to classify new statics
 			static RE::NiAVObject* thunk(RE::TESObjectSTAT* a_static, RE::TESObjectREFR* a_ref, bool a_arg3)
 			{
+				HookStats::Scope stats(HookStats::HOOK::kStaticsClone3D, a_ref ? a_ref->GetParentCell() : nullptr);
+
+				if (CallTrace::Recorder::GetSingleton().IsRecording()) {
+					SeasonManager::GetSingleton()->RecordCall(CallTrace::HOOK::kStaticsClone3D, a_ref ? a_ref->GetFormID() : 0, a_static->GetFormID());
+				}
+
 				const auto manager = Manager::GetSingleton();
 
 				auto       snowInfo = manager->GetSnowInfo(a_static);
@@ -93,6 +105,7 @@ namespace SnowSwap
 				auto singlePassSnowState = SWAP_TYPE::kSkip;
 
 				if (result == SWAP_RESULT::kSuccess) {
+					stats.hit();
 					if (snowInfo) {
 						auto& [origShader, snowType] = *snowInfo;
 						if (snowType == SNOW_TYPE::kMultiPass) {
@@ -110,6 +123,7 @@ namespace SnowSwap
 
 								tempNode->DeleteThis();  //refCount is zero, nothing else should touch this.
 								tempNode = nullptr;
+								stats.double_clone();
 
 							} else {
 								manager->ApplySinglePassSnow(tempNode);
@@ -157,10 +171,13 @@ namespace SnowSwap
 			{
 				const auto node = func(a_base, a_ref, a_arg3);
 
+				HookStats::Scope stats(HookStats::HOOK::kOtherFormsClone3D, a_ref ? a_ref->GetParentCell() : nullptr);
+
 				const auto manager = Manager::GetSingleton();
 				const auto result = manager->CanApplySnowShader(a_ref);
 
 				if (result == SWAP_RESULT::kSuccess) {
+					stats.hit();
 					manager->ApplySinglePassSnow(node);
 				} else if (result == SWAP_RESULT::kSeasonFail || result == SWAP_RESULT::kRefFail) {
 					manager->RemoveSinglePassSnow(node);
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <string_view>
+
+// ASCII case-insensitive substring search for model paths and editorIDs
+// Picks AVX2, SSE2 or scalar once at startup. Only depends on the standard library.
+namespace StringSearch
+{
+	// same results as clib_util::string::icontains, so an empty needle never matches
+	bool icontains(std::string_view a_haystack, std::string_view a_needle);
+
+	// reference implementation, used for short haystacks and as the fallback
+	bool icontains_scalar(std::string_view a_haystack, std::string_view a_needle);
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "FormCatalog.h"
+
+// Winter swap generation over a FormCatalog
+// Shared by the plugin and the offline generator in tools/SwapGenerator, so it only depends on the standard library.
+namespace SwapGenerator
+{
+	// catalog rows, base -> snow variant, sorted by base row
+	using Swaps = std::vector<std::pair<std::uint32_t, std::uint32_t>>;
+
+	// section names, in FormCatalog::TYPE order
+	inline constexpr std::array<std::string_view, static_cast<std::size_t>(FormCatalog::TYPE::kTotal)>
+		sectionNames{ "LandTextures", "Activators", "Furniture", "MovableStatics", "Statics", "Trees" };
+
+	std::optional<std::uint32_t> GenerateLandTextureSnowVariant(const FormCatalog::Catalog& a_catalog, std::uint32_t a_row);
+
+	// scratch allocations made while generating a single record type
+	struct Stats
+	{
+		std::size_t allocations{ 0 };
+		std::size_t peakBytes{ 0 };
+	};
+
+	// counts allocations passed through to a_upstream
+	class CountingResource final : public std::pmr::memory_resource
+	{
+	public:
+		explicit CountingResource(std::pmr::memory_resource* a_upstream) :
+			_upstream(a_upstream)
+		{}
+
+		[[nodiscard]] const Stats& stats() const { return _stats; }
+
+	private:
+		void* do_allocate(std::size_t a_bytes, std::size_t a_alignment) override;
+		void  do_deallocate(void* a_ptr, std::size_t a_bytes, std::size_t a_alignment) override;
+		bool  do_is_equal(const std::pmr::memory_resource& a_other) const noexcept override;
+
+		std::pmr::memory_resource* _upstream;
+		Stats                      _stats{};
+		std::size_t                _bytes{ 0 };
+	};
+
+	// scratch containers come from a per-call monotonic arena
+	Swaps GetSnowVariants(const FormCatalog::Catalog& a_catalog, FormCatalog::TYPE a_type, Stats* a_stats = nullptr);
+
+	// ;EDID|EDID
+	std::string GetComment(const FormCatalog::Catalog& a_catalog, std::uint32_t a_row, std::uint32_t a_snowRow);
+	// 0xID~Plugin|0xID~Plugin
+	std::string GetEntry(const FormCatalog::Catalog& a_catalog, std::uint32_t a_row, std::uint32_t a_snowRow);
+
+	// order-sensitive fnv1a over a section's entry and comment lines, so a regenerated section can be compared with the one on disk
+	class SectionHash
+	{
+	public:
+		void add(std::string_view a_entry, std::string_view a_comment);
+
+		[[nodiscard]] std::uint64_t value() const { return _hash; }
+
+	private:
+		void append(std::string_view a_str);
+
+		std::uint64_t _hash{ 0xCBF29CE484222325 };
+	};
+
+	std::uint64_t HashSection(const FormCatalog::Catalog& a_catalog, const Swaps& a_swaps);
+
+	// [section] header followed by a comment and entry line per swap
+	void WriteSection(std::ostream& a_stream, const FormCatalog::Catalog& a_catalog, FormCatalog::TYPE a_type, const Swaps& a_swaps);
+
+	// section of an existing formswap ini, hashed the same way as HashSection
+	struct Section
+	{
+		std::string_view name{};  // empty for anything before the first header
+		std::string_view text{};  // from the header line up to the next header
+		std::size_t      entries{ 0 };
+		std::uint64_t    hash{ SectionHash{}.value() };
+	};
+
+	std::vector<Section> SplitSections(std::string_view a_data);
+
+	// regenerated swaps in FormCatalog::TYPE order, nullopt keeps the existing section
+	using Regenerated = std::array<std::optional<Swaps>, static_cast<std::size_t>(FormCatalog::TYPE::kTotal)>;
+
+	// BOM, then a_existing with regenerated sections streamed in place of the old ones, and new sections at the end
+	void WriteFile(std::ostream& a_stream, const FormCatalog::Catalog& a_catalog, std::span<const Section> a_existing, const Regenerated& a_regenerated);
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+// Scoped timing spans for startup phases, worker tasks and season changes
+// Kept in a ring buffer and written next to the log in Chrome trace-event format (chrome://tracing, Perfetto).
+// Enabled with "Export Trace" in po3_SeasonsOfSkyrim.ini. Spans are recorded until settings are loaded, then dropped if it's off.
+namespace Trace
+{
+	void SetEnabled(bool a_enabled);
+	bool IsEnabled();
+
+	class Span
+	{
+	public:
+		explicit Span(std::string_view a_name, std::string_view a_category = "startup"sv);
+		Span(const Span&) = delete;
+		Span(Span&&) = delete;
+		~Span();
+
+		Span& operator=(const Span&) = delete;
+		Span& operator=(Span&&) = delete;
+
+		// shown as the span's args in the viewer
+		void SetDetail(std::string a_detail) { _detail = std::move(a_detail); }
+
+	private:
+		std::string_view                      _name;
+		std::string_view                      _category;
+		std::string                           _detail;
+		std::chrono::steady_clock::time_point _start;
+		bool                                  _enabled;
+	};
+
+	// rewrites the trace file with everything currently in the buffer
+	void Write();
+}
@@ -18,79 +18,6 @@ namespace util
 	}
 }
 
-namespace model
-{
-	inline bool contains_textureset(RE::TESModel* a_model, std::string_view a_txstPath)
-	{
-		if (const auto model = a_model->GetAsModelTextureSwap(); model && model->alternateTextures && model->numAlternateTextures > 0) {
-			const std::span altTextures{ model->alternateTextures, model->numAlternateTextures };
-
-			return std::ranges::any_of(altTextures, [&](const auto& textures) {
-				return textures.textureSet ? string::icontains(textures.textureSet->textures[0].textureName, a_txstPath) :
-				                             false;
-			});
-		}
-
-		return false;
-	}
-
-	inline bool only_contains_textureset(RE::TESModel* a_model, const std::pair<std::string_view, std::string_view>& a_txstPaths)
-	{
-		if (const auto model = a_model->GetAsModelTextureSwap(); model && model->alternateTextures && model->numAlternateTextures > 0) {
-			const std::span altTextures{ model->alternateTextures, model->numAlternateTextures };
-
-			return std::ranges::all_of(altTextures, [&](const auto& textures) {
-				if (const auto txst = textures.textureSet) {
-					return string::icontains(txst->textures[0].textureName, a_txstPaths.first) ||
-					       string::icontains(txst->textures[0].textureName, a_txstPaths.second);
-				}
-				return false;
-			});
-		}
-
-		return true;
-	}
-
-	inline bool only_contains_textureset(RE::TESModel* a_model, std::string_view a_txstPath)
-	{
-		if (const auto model = a_model->GetAsModelTextureSwap(); model && model->alternateTextures && model->numAlternateTextures > 0) {
-			const std::span altTextures{ model->alternateTextures, model->numAlternateTextures };
-
-			return std::ranges::all_of(altTextures, [&](const auto& textures) {
-				return textures.textureSet ? string::icontains(textures.textureSet->textures[0].textureName, a_txstPath) :
-				                             false;
-			});
-		}
-
-		return false;
-	}
-
-	inline bool must_only_contain_textureset(RE::TESModel* a_model, const std::pair<std::string_view, std::string_view>& a_txstPaths)
-	{
-		if (const auto model = a_model->GetAsModelTextureSwap(); model && model->alternateTextures && model->numAlternateTextures > 0) {
-			const std::span altTextures{ model->alternateTextures, model->numAlternateTextures };
-
-			return std::ranges::all_of(altTextures, [&](const auto& textures) {
-				if (const auto txst = textures.textureSet) {
-					return string::icontains(txst->textures[0].textureName, a_txstPaths.first) ||
-					       string::icontains(txst->textures[0].textureName, a_txstPaths.second);
-				}
-				return false;
-			});
-		}
-
-		return false;
-	}
-
-	inline std::string& process_model_path(std::string& a_path)
-	{
-		if (const auto it = a_path.rfind('\\'); it != std::string::npos) {
-			a_path = a_path.substr(it);
-		}
-		return a_path;
-	}
-}
-
 namespace raycast
 {
 	inline bool is_under_shelter(const RE::TESObjectREFR* a_ref)
@@ -132,17 +59,31 @@ namespace INI
 		a_ini.SetValue(a_section, a_key, string::join(a_value, a_deliminator).c_str(), a_comment);
 	}
 
+	//call only if g_mergeMapperInterface is set
+	inline std::pair<std::string, RE::FormID> remap_form(RE::FormID a_localFormID, std::string_view a_modName)
+	{
+		//season inis are resolved on worker threads, and the interface makes no thread-safety guarantees
+		static std::mutex mergeMapperLock;
+		std::scoped_lock  locker(mergeMapperLock);
+		const std::string modName(a_modName);
+		const auto [mergedModName, mergedFormID] = g_mergeMapperInterface->GetNewFormID(modName.c_str(), a_localFormID);
+		return { mergedModName, mergedFormID };
+	}
+
+	inline RE::FormID lookup_form(RE::FormID a_localFormID, std::string_view a_modName)
+	{
+		if (g_mergeMapperInterface) {
+			const auto [mergedModName, mergedFormID] = remap_form(a_localFormID, a_modName);
+			return RE::TESDataHandler::GetSingleton()->LookupFormID(mergedFormID, mergedModName);
+		}
+		return RE::TESDataHandler::GetSingleton()->LookupFormID(a_localFormID, a_modName);
+	}
+
 	inline RE::FormID parse_form(const std::string& a_str)
 	{
 		if (const auto splitID = string::split(a_str, "~"); splitID.size() == 2) {
-			const auto  formID = string::to_num<RE::FormID>(splitID[0], true);
-			const auto& modName = splitID[1];
-			if (g_mergeMapperInterface) {
-				const auto [mergedModName, mergedFormID] = g_mergeMapperInterface->GetNewFormID(modName.c_str(), formID);
-				return RE::TESDataHandler::GetSingleton()->LookupFormID(mergedFormID, mergedModName);
-			} else {
-				return RE::TESDataHandler::GetSingleton()->LookupFormID(formID, modName);
-			}
+			const auto formID = string::to_num<RE::FormID>(splitID[0], true);
+			return lookup_form(formID, splitID[1]);
 		}
 		if (const auto form = RE::TESForm::LookupByEditorID(a_str); form) {
 			return form->GetFormID();
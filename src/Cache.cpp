@@ -2,19 +2,48 @@
 
 namespace Cache
 {
+	std::uint8_t DataHolder::classify_texture_set(const RE::BGSTextureSet* a_txst)
+	{
+		static constexpr std::array<std::pair<std::string_view, TXST::FLAG>, 3> keywords{
+			std::make_pair("Snow"sv, TXST::kSnow),
+			std::make_pair("Mask"sv, TXST::kMask),
+			std::make_pair("Frozen"sv, TXST::kFrozen)
+		};
+
+		const std::string_view path = a_txst->textures[0].textureName;
+
+		std::uint8_t flags = TXST::kNone;
+		for (const auto& [keyword, flag] : keywords) {
+			if (StringSearch::icontains(path, keyword)) {
+				flags |= flag;
+			}
+		}
+		return flags;
+	}
+
 	void DataHolder::GetData()
 	{
 		if (const auto dataHandler = RE::TESDataHandler::GetSingleton()) {
+			const auto& textureSets = dataHandler->GetFormArray<RE::BGSTextureSet>();
+			_textureSetFlags.reserve(textureSets.size());
+			for (const auto& txst : textureSets) {
+				if (txst) {
+					_textureSetFlags.emplace(txst->GetFormID(), classify_texture_set(txst));
+				}
+			}
 			for (const auto& landTexture : dataHandler->GetFormArray<RE::TESLandTexture>()) {
 				if (landTexture->textureSet) {
 					_textureToLandMap.emplace(landTexture->textureSet->GetFormID(), landTexture->GetFormID());
 				}
 			}
 			for (const auto& mat : dataHandler->GetFormArray<RE::BGSMaterialObject>()) {
-				if (auto eid = edid::get_editorID(mat); string::icontains(eid, "Snow")) {
+				if (auto eid = edid::get_editorID(mat); StringSearch::icontains(eid, "Snow")) {
 					_snowShaders.emplace(mat->GetFormID());
 				}
 			}
+			build_catalog(dataHandler);
+			//generation reads the catalog's per row flags from here on
+			_textureSetFlags = {};
 		}
 
 		const auto sosShaderSP = RE::TESForm::LookupByEditorID<RE::BGSMaterialObject>("SOS_WIN_SnowMaterialObjectSP");
@@ -41,18 +70,126 @@ namespace Cache
 		return _snowShaders.contains(a_form->GetFormID());
 	}
 
-	RE::TESBoundObject* DataHolder::GetOriginalBase(RE::TESObjectREFR* a_ref)
+	template <class T>
+	void DataHolder::add_to_catalog(RE::TESDataHandler* a_dataHandler, FormCatalog::TYPE a_type)
 	{
-		Locker locker(_originalsLock);
+		std::vector<std::uint8_t> altTextures;
+
+		for (const auto& form : a_dataHandler->GetFormArray<T>()) {
+			const auto file = form ? form->GetFile(0) : nullptr;
+			if (!file) {
+				continue;
+			}
 
-		const auto it = _originals.find(a_ref->GetFormID());
-		return it != _originals.end() ? RE::TESForm::LookupByID<RE::TESBoundObject>(it->second) :
-		                                a_ref->GetBaseObject();
+			const auto editorID = edid::get_editorID(form);
+
+			FormCatalog::Catalog::Row row{ form->GetFormID(), form->GetLocalFormID(), a_type, file->fileName };
+			row.editorID = editorID;
+
+			altTextures.clear();
+
+			if constexpr (std::is_same_v<T, RE::TESLandTexture>) {
+				auto material = FormCatalog::LAND_MATERIAL::kOther;
+				switch (form->materialType ? form->materialType->materialID : RE::MATERIAL_ID::kNone) {
+				case RE::MATERIAL_ID::kGrass:
+					material = FormCatalog::LAND_MATERIAL::kGrass;
+					break;
+				case RE::MATERIAL_ID::kDirt:
+					material = FormCatalog::LAND_MATERIAL::kDirt;
+					break;
+				case RE::MATERIAL_ID::kStone:
+				case RE::MATERIAL_ID::kStoneBroken:
+				case RE::MATERIAL_ID::kGravel:
+					material = FormCatalog::LAND_MATERIAL::kStone;
+					break;
+				case RE::MATERIAL_ID::kSnow:
+				case RE::MATERIAL_ID::kIce:
+				case RE::MATERIAL_ID::kSand:
+				case RE::MATERIAL_ID::kMud:
+					material = FormCatalog::LAND_MATERIAL::kNoSnowVariant;
+					break;
+				default:
+					break;
+				}
+				row.material = static_cast<std::uint32_t>(material);
+				if (!form->textureGrassList.empty()) {
+					row.flags |= FormCatalog::ROW::kHasGrass;
+				}
+			} else {
+				row.model = form->GetModel();
+				if (const auto model = form->GetAsModelTextureSwap(); model && model->alternateTextures) {
+					for (const auto& texture : std::span(model->alternateTextures, model->numAlternateTextures)) {
+						altTextures.push_back(texture.textureSet ? GetTextureSetFlags(texture.textureSet) : TXST::kNone);
+					}
+				}
+				if constexpr (std::is_same_v<T, RE::TESObjectSTAT>) {
+					if (const auto mat = form->data.materialObj) {
+						row.material = mat->GetFormID();
+						if (IsSnowShader(mat)) {
+							row.flags |= FormCatalog::ROW::kSnowMaterial;
+						}
+					}
+				}
+			}
+
+			row.altTextures = altTextures;
+			_catalog.add(row);
+		}
+	}
+
+	void DataHolder::build_catalog(RE::TESDataHandler* a_dataHandler)
+	{
+		const auto start = std::chrono::steady_clock::now();
+
+		_catalog.clear();
+
+		add_to_catalog<RE::TESLandTexture>(a_dataHandler, FormCatalog::TYPE::kLandTexture);
+		add_to_catalog<RE::TESObjectACTI>(a_dataHandler, FormCatalog::TYPE::kActivator);
+		add_to_catalog<RE::TESFurniture>(a_dataHandler, FormCatalog::TYPE::kFurniture);
+		add_to_catalog<RE::BGSMovableStatic>(a_dataHandler, FormCatalog::TYPE::kMovableStatic);
+		add_to_catalog<RE::TESObjectSTAT>(a_dataHandler, FormCatalog::TYPE::kStatic);
+		add_to_catalog<RE::TESObjectTREE>(a_dataHandler, FormCatalog::TYPE::kTree);
+
+		const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+		logger::info("Form catalog : {} forms, {} strings, {} plugins in {} ms", _catalog.size(), _catalog.strings.size(), _catalog.fileNames.size(), elapsed.count());
+	}
+
+	std::uint8_t DataHolder::GetTextureSetFlags(const RE::BGSTextureSet* a_txst) const
+	{
+		const auto it = _textureSetFlags.find(a_txst->GetFormID());
+		return it != _textureSetFlags.end() ? it->second : classify_texture_set(a_txst);
+	}
+
+	RE::TESBoundObject* DataHolder::GetOriginalBase(RE::TESObjectREFR* a_ref)
+	{
+		const auto originalBaseID = _originals.Get(a_ref->GetFormID());
+		return originalBaseID != 0 ? RE::TESForm::LookupByID<RE::TESBoundObject>(originalBaseID) :
+		                             a_ref->GetBaseObject();
 	}
 
 	void DataHolder::SetOriginalBase(const RE::TESObjectREFR* a_ref, const RE::TESBoundObject* a_originalBase)
 	{
-		Locker locker(_originalsLock);
-		_originals.emplace(a_ref->GetFormID(), a_originalBase->GetFormID());
+		_originals.Set(a_ref->GetFormID(), a_originalBase->GetFormID());
+	}
+
+	void DataHolder::RestoreOriginalBase(RE::TESObjectREFR* a_ref)
+	{
+		const auto originalBaseID = _originals.Release(a_ref->GetFormID());
+		if (const auto originalBase = originalBaseID != 0 ? RE::TESForm::LookupByID<RE::TESBoundObject>(originalBaseID) : nullptr; originalBase && a_ref->GetBaseObject() != originalBase) {
+			a_ref->SetObjectReference(originalBase);
+		}
+	}
+
+	bool DataHolder::IsTracked(const RE::TESObjectREFR* a_ref) const
+	{
+		return _originals.Get(a_ref->GetFormID()) != 0;
+	}
+
+	void DataHolder::GetMemoryStats(std::vector<MemoryStats::Table>& a_tables) const
+	{
+		a_tables.push_back(MemoryStats::GetTable("Cache::TextureToLand", _textureToLandMap));
+		a_tables.push_back(MemoryStats::GetTable("Cache::SnowShaders", _snowShaders));
+		a_tables.push_back({ "Cache::FormCatalog", _catalog.size(), _catalog.formIDs.capacity(), 0, _catalog.get_memory_usage() });
+		a_tables.push_back({ "Cache::Originals", _originals.size(), _originals.capacity(), _originals.bucket_count(), _originals.get_memory_usage() });
 	}
 }
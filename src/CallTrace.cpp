@@ -0,0 +1,189 @@
+#include "CallTrace.h"
+
+#include <istream>
+#include <utility>
+
+namespace CallTrace
+{
+	// threads are already gone when statics are destroyed at exit, so the writer isn't joined and whatever it didn't get to is written here
+	Recorder::~Recorder()
+	{
+		if (_writer.joinable()) {
+			_writer.detach();
+		}
+
+		std::unique_lock locker(_queueLock, std::try_to_lock);
+		if (!_recording || !locker || _writing) {
+			return;
+		}
+		_recording = false;
+
+		for (const auto& buffer : _queue) {
+			write(buffer);
+		}
+		for (const auto& thread : _threads) {
+			if (std::unique_lock bufferLocker(thread->lock, std::try_to_lock); bufferLocker) {
+				write(thread->records);
+			}
+		}
+		_file.close();
+	}
+
+	bool Recorder::Start(const std::filesystem::path& a_path)
+	{
+		std::scoped_lock locker(_lock);
+		if (_recording) {
+			return false;
+		}
+
+		_file.open(a_path, std::ios::binary | std::ios::trunc);
+		if (!_file) {
+			return false;
+		}
+
+		_file.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+		_file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+
+		{
+			std::scoped_lock threadsLocker(_threadsLock);
+			for (const auto& thread : _threads) {
+				std::scoped_lock bufferLocker(thread->lock);
+				thread->records.clear();
+			}
+		}
+
+		_writer = std::jthread([this](std::stop_token a_stop) { Run(a_stop); });
+		_recording = true;
+
+		return static_cast<bool>(_file);
+	}
+
+	void Recorder::Stop()
+	{
+		std::scoped_lock locker(_lock);
+		if (!_recording) {
+			return;
+		}
+
+		_recording = false;
+		collect();
+
+		// the writer drains the queue before it exits
+		_writer.request_stop();
+		_writer.join();
+		_file.close();
+	}
+
+	void Recorder::Record(const CallTrace::Record& a_record)
+	{
+		if (!_recording.load(std::memory_order_relaxed)) {
+			return;
+		}
+
+		auto&            buffer = get_thread_buffer();
+		std::scoped_lock locker(buffer.lock);
+
+		buffer.records.push_back(a_record);
+		if (buffer.records.size() < bufferSize) {
+			return;
+		}
+
+		// queued before the lock is released, so a Flush can't queue this thread's newer records ahead of these
+		submit(std::exchange(buffer.records, {}));
+		buffer.records.reserve(bufferSize);
+	}
+
+	void Recorder::Flush()
+	{
+		std::scoped_lock locker(_lock);
+		if (!_recording) {
+			return;
+		}
+
+		collect();
+
+		// the writer can't take the next batch while this holds the queue lock
+		std::unique_lock queueLocker(_queueLock);
+		_drained.wait(queueLocker, [&] { return _queue.empty() && !_writing; });
+		_file.flush();
+	}
+
+	Recorder::ThreadBuffer& Recorder::get_thread_buffer()
+	{
+		thread_local ThreadBuffer* buffer = [this] {
+			std::scoped_lock locker(_threadsLock);
+			auto& thread = _threads.emplace_back(std::make_unique<ThreadBuffer>());
+			thread->records.reserve(bufferSize);
+			return thread.get();
+		}();
+		return *buffer;
+	}
+
+	void Recorder::submit(Buffer&& a_buffer)
+	{
+		{
+			std::scoped_lock locker(_queueLock);
+			_queue.push_back(std::move(a_buffer));
+		}
+		_queued.notify_one();
+	}
+
+	// hands every thread's partly filled buffer to the writer
+	void Recorder::collect()
+	{
+		std::scoped_lock locker(_threadsLock);
+		for (const auto& thread : _threads) {
+			std::scoped_lock bufferLocker(thread->lock);
+			if (!thread->records.empty()) {
+				submit(std::exchange(thread->records, {}));
+			}
+		}
+	}
+
+	void Recorder::write(const Buffer& a_buffer)
+	{
+		_file.write(reinterpret_cast<const char*>(a_buffer.data()), static_cast<std::streamsize>(a_buffer.size() * sizeof(CallTrace::Record)));
+	}
+
+	void Recorder::Run(std::stop_token a_stop)
+	{
+		std::unique_lock locker(_queueLock);
+		while (true) {
+			// only returns with an empty queue once a stop is requested
+			if (!_queued.wait(locker, a_stop, [&] { return !_queue.empty(); })) {
+				return;
+			}
+
+			auto buffers = std::exchange(_queue, {});
+			_writing = true;
+			locker.unlock();
+
+			for (const auto& buffer : buffers) {
+				write(buffer);
+			}
+
+			locker.lock();
+			_writing = false;
+			_drained.notify_all();
+		}
+	}
+
+	bool Read(std::istream& a_stream, std::vector<Record>& a_records)
+	{
+		std::uint32_t fileMagic = 0;
+		std::uint32_t fileVersion = 0;
+		if (!a_stream.read(reinterpret_cast<char*>(&fileMagic), sizeof(fileMagic)) || fileMagic != magic ||
+			!a_stream.read(reinterpret_cast<char*>(&fileVersion), sizeof(fileVersion)) || fileVersion != version) {
+			return false;
+		}
+
+		a_records.clear();
+		Record record;
+		while (a_stream.read(reinterpret_cast<char*>(&record), sizeof(record))) {
+			if (record.hook < HOOK::kTotal) {
+				a_records.push_back(record);
+			}
+		}
+		return true;
+	}
+}
@@ -0,0 +1,334 @@
+#include "FormCatalog.h"
+
+#include <algorithm>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+
+namespace FormCatalog
+{
+	namespace detail
+	{
+		constexpr std::uint32_t magic = 0x54414346;  // FCAT
+		constexpr std::uint32_t version = 1;
+
+		constexpr char to_lower(char a_ch)
+		{
+			return a_ch >= 'A' && a_ch <= 'Z' ? static_cast<char>(a_ch + ('a' - 'A')) : a_ch;
+		}
+
+		template <class T>
+		void write(std::ostream& a_stream, const T& a_value)
+		{
+			a_stream.write(reinterpret_cast<const char*>(&a_value), sizeof(T));
+		}
+
+		template <class T>
+		void write(std::ostream& a_stream, const std::vector<T>& a_column)
+		{
+			write(a_stream, static_cast<std::uint32_t>(a_column.size()));
+			a_stream.write(reinterpret_cast<const char*>(a_column.data()), static_cast<std::streamsize>(a_column.size() * sizeof(T)));
+		}
+
+		void write(std::ostream& a_stream, const std::vector<std::string>& a_strings)
+		{
+			write(a_stream, static_cast<std::uint32_t>(a_strings.size()));
+			for (const auto& str : a_strings) {
+				write(a_stream, static_cast<std::uint32_t>(str.size()));
+				a_stream.write(str.data(), static_cast<std::streamsize>(str.size()));
+			}
+		}
+
+		// counts in the file are only trusted up to the bytes left in the stream, so a corrupt size fails the load instead of allocating
+		class Reader
+		{
+		public:
+			explicit Reader(std::istream& a_stream) :
+				_stream(a_stream)
+			{
+				if (const auto start = a_stream.tellg(); start != std::streampos(-1)) {
+					if (a_stream.seekg(0, std::ios::end)) {
+						_remaining = static_cast<std::uint64_t>(a_stream.tellg() - start);
+					}
+					a_stream.clear();
+					a_stream.seekg(start);
+				}
+			}
+
+			template <class T>
+			bool read(T& a_value)
+			{
+				return take(sizeof(T)) && _stream.read(reinterpret_cast<char*>(&a_value), sizeof(T));
+			}
+
+			template <class T>
+			bool read(std::vector<T>& a_column)
+			{
+				std::uint32_t size = 0;
+				if (!read(size) || !take(static_cast<std::uint64_t>(size) * sizeof(T))) {
+					return false;
+				}
+				a_column.resize(size);
+				return static_cast<bool>(_stream.read(reinterpret_cast<char*>(a_column.data()), static_cast<std::streamsize>(size * sizeof(T))));
+			}
+
+			bool read(std::vector<std::string>& a_strings)
+			{
+				std::uint32_t count = 0;
+				// every string has at least its size
+				if (!read(count) || static_cast<std::uint64_t>(count) * sizeof(std::uint32_t) > _remaining) {
+					return false;
+				}
+				a_strings.resize(count);
+				for (auto& str : a_strings) {
+					std::uint32_t size = 0;
+					if (!read(size) || !take(size)) {
+						return false;
+					}
+					str.resize(size);
+					if (!_stream.read(str.data(), size)) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+		private:
+			bool take(std::uint64_t a_bytes)
+			{
+				if (a_bytes > _remaining) {
+					return false;
+				}
+				_remaining -= a_bytes;
+				return true;
+			}
+
+			std::istream& _stream;
+			std::uint64_t _remaining{ std::numeric_limits<std::uint64_t>::max() };  // unknown for unseekable streams
+		};
+	}
+
+	void Catalog::clear()
+	{
+		formIDs.clear();
+		localFormIDs.clear();
+		types.clear();
+		files.clear();
+		models.clear();
+		basenameHashes.clear();
+		editorIDs.clear();
+		materials.clear();
+		rowFlags.clear();
+		altTextureOffsets.assign(1, 0);
+		altTextureFlags.clear();
+		fileNames.clear();
+		strings.assign(1, std::string{});
+
+		_stringIndex.clear();
+		_stringIndex.emplace(std::string{}, 0);
+		_fileIndex.clear();
+		_rowIndex.clear();
+	}
+
+	std::size_t Catalog::get_memory_usage() const
+	{
+		constexpr auto column = [](const auto& a_column) {
+			return a_column.capacity() * sizeof(typename std::remove_cvref_t<decltype(a_column)>::value_type);
+		};
+		constexpr auto string_table = [](const std::vector<std::string>& a_strings) {
+			std::size_t bytes = a_strings.capacity() * sizeof(std::string);
+			for (const auto& str : a_strings) {
+				if (str.capacity() > std::string{}.capacity()) {
+					bytes += str.capacity() + 1;
+				}
+			}
+			return bytes;
+		};
+		constexpr auto index = [](const auto& a_index) {
+			using T = std::remove_cvref_t<decltype(a_index)>;
+			return a_index.values().capacity() * sizeof(typename T::value_type) + a_index.bucket_count() * sizeof(typename T::bucket_type);
+		};
+
+		return column(formIDs) + column(localFormIDs) + column(types) + column(files) + column(models) + column(basenameHashes) +
+		       column(editorIDs) + column(materials) + column(rowFlags) + column(altTextureOffsets) + column(altTextureFlags) +
+		       string_table(fileNames) + string_table(strings) + index(_stringIndex) + index(_fileIndex) + index(_rowIndex);
+	}
+
+	std::uint64_t Catalog::hash_basename(std::string_view a_model)
+	{
+		if (const auto pos = a_model.find_last_of("\\/"); pos != std::string_view::npos) {
+			a_model.remove_prefix(pos);
+		}
+
+		std::uint64_t hash = 0xCBF29CE484222325;
+		for (const auto ch : a_model) {
+			hash ^= static_cast<std::uint8_t>(detail::to_lower(ch));
+			hash *= 0x100000001B3;
+		}
+		return hash;
+	}
+
+	StringID Catalog::intern(std::string_view a_str)
+	{
+		const auto [it, inserted] = _stringIndex.try_emplace(std::string(a_str), static_cast<StringID>(strings.size()));
+		if (inserted) {
+			strings.emplace_back(a_str);
+		}
+		return it->second;
+	}
+
+	std::uint16_t Catalog::add_file(std::string_view a_file)
+	{
+		const auto [it, inserted] = _fileIndex.try_emplace(std::string(a_file), static_cast<std::uint16_t>(fileNames.size()));
+		if (inserted) {
+			fileNames.emplace_back(a_file);
+		}
+		return it->second;
+	}
+
+	std::uint32_t Catalog::add(const Row& a_row)
+	{
+		std::string model(a_row.model);
+		std::ranges::transform(model, model.begin(), detail::to_lower);
+
+		const auto row = static_cast<std::uint32_t>(size());
+
+		formIDs.push_back(a_row.formID);
+		localFormIDs.push_back(a_row.localFormID);
+		types.push_back(a_row.type);
+		files.push_back(add_file(a_row.file));
+		models.push_back(intern(model));
+		basenameHashes.push_back(hash_basename(model));
+		editorIDs.push_back(intern(a_row.editorID));
+		materials.push_back(a_row.material);
+		rowFlags.push_back(a_row.flags);
+		altTextureFlags.insert(altTextureFlags.end(), a_row.altTextures.begin(), a_row.altTextures.end());
+		altTextureOffsets.push_back(static_cast<std::uint32_t>(altTextureFlags.size()));
+
+		_rowIndex.insert_or_assign(a_row.formID, row);
+
+		return row;
+	}
+
+	std::optional<std::uint32_t> Catalog::find(std::uint32_t a_formID) const
+	{
+		const auto it = _rowIndex.find(a_formID);
+		return it != _rowIndex.end() ? std::optional(it->second) : std::nullopt;
+	}
+
+	std::vector<std::uint32_t> Catalog::get_rows(TYPE a_type) const
+	{
+		std::vector<std::uint32_t> rows;
+		for (std::uint32_t i = 0; i < size(); ++i) {
+			if (types[i] == a_type) {
+				rows.push_back(i);
+			}
+		}
+		return rows;
+	}
+
+	std::span<const std::uint8_t> Catalog::get_alt_textures(std::uint32_t a_row) const
+	{
+		return std::span(altTextureFlags).subspan(altTextureOffsets[a_row], altTextureOffsets[a_row + 1] - altTextureOffsets[a_row]);
+	}
+
+	bool Catalog::contains_textureset(std::uint32_t a_row, std::uint8_t a_flags) const
+	{
+		return std::ranges::any_of(get_alt_textures(a_row), [&](auto a_txst) { return (a_txst & a_flags) != 0; });
+	}
+
+	bool Catalog::only_contains_textureset(std::uint32_t a_row, std::uint8_t a_flags) const
+	{
+		return std::ranges::all_of(get_alt_textures(a_row), [&](auto a_txst) { return (a_txst & a_flags) != 0; });
+	}
+
+	bool Catalog::must_only_contain_textureset(std::uint32_t a_row, std::uint8_t a_flags) const
+	{
+		return !get_alt_textures(a_row).empty() && only_contains_textureset(a_row, a_flags);
+	}
+
+	bool Catalog::Save(std::ostream& a_stream) const
+	{
+		detail::write(a_stream, detail::magic);
+		detail::write(a_stream, detail::version);
+
+		detail::write(a_stream, formIDs);
+		detail::write(a_stream, localFormIDs);
+		detail::write(a_stream, types);
+		detail::write(a_stream, files);
+		detail::write(a_stream, models);
+		detail::write(a_stream, basenameHashes);
+		detail::write(a_stream, editorIDs);
+		detail::write(a_stream, materials);
+		detail::write(a_stream, rowFlags);
+		detail::write(a_stream, altTextureOffsets);
+		detail::write(a_stream, altTextureFlags);
+		detail::write(a_stream, fileNames);
+		detail::write(a_stream, strings);
+
+		return static_cast<bool>(a_stream);
+	}
+
+	bool Catalog::Load(std::istream& a_stream)
+	{
+		clear();
+
+		detail::Reader reader(a_stream);
+
+		std::uint32_t magic = 0;
+		std::uint32_t version = 0;
+		if (!reader.read(magic) || magic != detail::magic || !reader.read(version) || version != detail::version) {
+			return false;
+		}
+
+		const bool read =
+			reader.read(formIDs) &&
+			reader.read(localFormIDs) &&
+			reader.read(types) &&
+			reader.read(files) &&
+			reader.read(models) &&
+			reader.read(basenameHashes) &&
+			reader.read(editorIDs) &&
+			reader.read(materials) &&
+			reader.read(rowFlags) &&
+			reader.read(altTextureOffsets) &&
+			reader.read(altTextureFlags) &&
+			reader.read(fileNames) &&
+			reader.read(strings);
+
+		const auto rows = formIDs.size();
+		const bool consistent = read && !strings.empty() && strings.front().empty() &&
+		                        localFormIDs.size() == rows && types.size() == rows && files.size() == rows &&
+		                        models.size() == rows && basenameHashes.size() == rows && editorIDs.size() == rows &&
+		                        materials.size() == rows && rowFlags.size() == rows && altTextureOffsets.size() == rows + 1 &&
+		                        std::ranges::is_sorted(altTextureOffsets) && altTextureOffsets.back() == altTextureFlags.size() &&
+		                        std::ranges::all_of(types, [](auto a_type) { return a_type < TYPE::kTotal; }) &&
+		                        std::ranges::all_of(files, [&](auto a_file) { return a_file < fileNames.size(); }) &&
+		                        std::ranges::all_of(models, [&](auto a_id) { return a_id < strings.size(); }) &&
+		                        std::ranges::all_of(editorIDs, [&](auto a_id) { return a_id < strings.size(); });
+		if (!consistent) {
+			clear();
+			return false;
+		}
+
+		rebuild_index();
+		return true;
+	}
+
+	void Catalog::rebuild_index()
+	{
+		_stringIndex.clear();
+		for (StringID i = 0; i < strings.size(); ++i) {
+			_stringIndex.try_emplace(strings[i], i);
+		}
+		_fileIndex.clear();
+		for (std::uint16_t i = 0; i < fileNames.size(); ++i) {
+			_fileIndex.try_emplace(fileNames[i], i);
+		}
+		_rowIndex.clear();
+		for (std::uint32_t i = 0; i < formIDs.size(); ++i) {
+			_rowIndex.insert_or_assign(formIDs[i], i);
+		}
+	}
+}
@@ -0,0 +1,114 @@
+#include "FormResolver.h"
+
+#include <algorithm>
+
+namespace FormResolver
+{
+	std::uint32_t Resolver::get_formID(std::uint32_t a_prefix, std::uint32_t a_localID)
+	{
+		// light plugins (0xFE) only own the low 12 bits
+		return (a_prefix >> 24) == 0xFE ? a_prefix | (a_localID & 0xFFF) : a_prefix | (a_localID & 0xFFFFFF);
+	}
+
+	void Resolver::resolve_plugin(std::string_view a_name, Plugin& a_plugin) const
+	{
+		a_plugin.resolved = true;
+		a_plugin.prefix = _loadOrder.GetPluginPrefix(a_name);
+	}
+
+	std::optional<std::uint32_t> Resolver::get_merged_prefix(const std::string& a_plugin)
+	{
+		auto [it, inserted] = _mergedPrefixes.try_emplace(a_plugin);
+		if (inserted) {
+			it->second = _loadOrder.GetPluginPrefix(a_plugin);
+		}
+		return it->second;
+	}
+
+	void Resolver::Resolve(std::span<const FormSwapParser::FormRef> a_refs, std::span<std::uint32_t> a_formIDs)
+	{
+		// group references by plugin
+		std::vector<std::uint32_t> slots(a_refs.size());
+		for (std::size_t i = 0; i < a_refs.size(); ++i) {
+			if (const auto& ref = a_refs[i]; !ref.isEditorID) {
+				const auto it = _plugins.try_emplace(ref.name).first;
+				slots[i] = static_cast<std::uint32_t>(it - _plugins.begin());
+			}
+		}
+
+		// resolve each plugin once
+		for (auto& [name, plugin] : _plugins) {
+			if (!plugin.resolved) {
+				resolve_plugin(name, plugin);
+			}
+		}
+
+		const auto remapping = _loadOrder.HasRemapping();
+
+		for (std::size_t i = 0; i < a_refs.size(); ++i) {
+			const auto& ref = a_refs[i];
+			if (ref.isEditorID) {
+				a_formIDs[i] = _loadOrder.LookupEditorID(ref.name);
+				continue;
+			}
+
+			auto& plugin = (_plugins.begin() + slots[i])->second;
+			if (!remapping) {
+				a_formIDs[i] = plugin.prefix ? get_formID(*plugin.prefix, ref.localID) : 0;
+				continue;
+			}
+
+			// decided per form, a plugin can be partially merged
+			auto [it, inserted] = plugin.remapped.try_emplace(ref.localID, 0);
+			if (inserted) {
+				const auto [mergedPlugin, mergedLocalID] = _loadOrder.Remap(ref.name, ref.localID);
+				const auto prefix = mergedPlugin == ref.name ? plugin.prefix : get_merged_prefix(mergedPlugin);
+				if (prefix) {
+					it->second = get_formID(*prefix, mergedLocalID);
+				}
+			}
+			a_formIDs[i] = it->second;
+		}
+	}
+
+	void ResolveRuns(const FormSwapParser::Document& a_document, const ILoadOrder& a_loadOrder, std::span<std::vector<FormPair>> a_runs)
+	{
+		const auto& entries = a_document.entries;
+
+		// base and swap refs interleaved, so one batch resolves both
+		std::vector<FormSwapParser::FormRef> refs;
+		refs.reserve(entries.size() * 2);
+		for (const auto& entry : entries) {
+			refs.push_back(entry.base);
+			refs.push_back(entry.swap);
+		}
+
+		std::vector<std::uint32_t> formIDs(refs.size());
+		Resolver(a_loadOrder).Resolve(refs, formIDs);
+
+		for (std::size_t i = 0; i < a_runs.size() && i < a_document.sectionSizes.size(); ++i) {
+			a_runs[i].reserve(a_document.sectionSizes[i]);
+		}
+
+		for (std::size_t i = 0; i < entries.size(); ++i) {
+			const auto formID = formIDs[i * 2];
+			const auto swapFormID = formIDs[i * 2 + 1];
+
+			if (formID != 0 && swapFormID != 0 && entries[i].section < a_runs.size()) {
+				a_runs[entries[i].section].emplace_back(formID, swapFormID);
+			}
+		}
+
+		for (auto& run : a_runs) {
+			std::ranges::stable_sort(run, {}, &FormPair::first);
+
+			auto out = run.begin();
+			for (auto it = run.begin(); it != run.end();) {
+				const auto next = std::find_if(it, run.end(), [&](const auto& a_pair) { return a_pair.first != it->first; });
+				*out++ = *std::prev(next);
+				it = next;
+			}
+			run.erase(out, run.end());
+		}
+	}
+}
@@ -1,4 +1,5 @@
 #include "FormSwapMap.h"
+#include "Persistence.h"
 
 FormSwapMap::FormSwapMap()
 {
@@ -7,216 +8,209 @@ FormSwapMap::FormSwapMap()
 	}
 }
 
-RE::TESLandTexture* FormSwapMap::GenerateLandTextureSnowVariant(const RE::TESLandTexture* a_landTexture)
+namespace
 {
-	static constexpr std::array blackList = { "Snow"sv, "Ice"sv, "Winter"sv, "Frozen"sv, "Coast"sv, "River"sv };
-
-	const auto editorID = edid::get_editorID(a_landTexture);
-	if (!editorID.empty() && std::ranges::any_of(blackList, [&](const auto str) { return string::icontains(editorID, str); })) {
-		return nullptr;
-	}
-
-	static constexpr RE::FormID LSnow01 = 0x0000089B;
-	static constexpr RE::FormID LSnow02 = 0x0006A1B1;
-
-	const auto mat = a_landTexture->materialType;
-	const auto matID = mat ? mat->materialID : RE::MATERIAL_ID::kNone;
-
-	RE::FormID formID;
-
-	switch (matID) {
-	case RE::MATERIAL_ID::kGrass:
+	class GameLoadOrder final : public FormResolver::ILoadOrder
+	{
+	public:
+		std::optional<std::uint32_t> GetPluginPrefix(std::string_view a_plugin) const override
 		{
-			static constexpr RE::FormID LGrassSnow01NoGrass = 0x0008B01E;
-			static constexpr RE::FormID LGrassSnow01 = 0x00000894;
-
-			switch (a_landTexture->GetFormID()) {
-			case 0x0001342A:  // LFieldGrass02
-			case 0x00024E46:  // LFieldGrass01NoGrass
-			case 0x00024E30:  // LTundra01
-			case 0x000A2741:  // LTundra01NoGrass
-				formID = LSnow01;
-				break;
-			case 0x000134B7:  // LFieldDirtGrass01
-			case 0x000300E4:  // LTundra02
-				formID = LSnow02;
-				break;
-			default:
-				formID = !a_landTexture->textureGrassList.empty() ? LGrassSnow01 : LGrassSnow01NoGrass;
-				break;
+			const auto dataHandler = RE::TESDataHandler::GetSingleton();
+			const auto file = dataHandler->LookupModByName(a_plugin);
+			if (!file || file->compileIndex == 0xFF) {
+				return std::nullopt;
 			}
+			return dataHandler->LookupFormID(0, a_plugin);
 		}
-		break;
-	case RE::MATERIAL_ID::kDirt:
+
+		std::pair<std::string, std::uint32_t> Remap(std::string_view a_plugin, std::uint32_t a_localID) const override
 		{
-			static constexpr RE::FormID LDirtSnowPath01 = 0x0001B082;
-
-			switch (a_landTexture->GetFormID()) {
-			case 0x00000C16:  // LDirt02
-				formID = LSnow02;
-				break;
-			case 0xB424C:  // LDirtPath01
-				formID = LDirtSnowPath01;
-				break;
-			default:
-				formID = LSnow01;
-				break;
-			}
+			return INI::remap_form(a_localID, a_plugin);
 		}
-		break;
-	case RE::MATERIAL_ID::kStone:
-	case RE::MATERIAL_ID::kStoneBroken:
-	case RE::MATERIAL_ID::kGravel:
+
+		bool HasRemapping() const override
 		{
-			static constexpr RE::FormID LSnowRocks01 = 0x0006A1AF;
-			static constexpr RE::FormID LSnowRockswGrass = 0x000F871F;
-
-			switch (a_landTexture->GetFormID()) {
-			case 0x0002C6C6:  // LTundraRocks01
-				formID = LSnowRocks01;
-				break;
-			case 0x0006DE8B:  // LTundraRocks01NoRocks
-				formID = LSnow01;
-				break;
-			default:
-				formID = !a_landTexture->textureGrassList.empty() ? LSnowRockswGrass : LSnowRocks01;
-				break;
-			}
+			return g_mergeMapperInterface != nullptr;
 		}
-		break;
-	case RE::MATERIAL_ID::kSnow:
-	case RE::MATERIAL_ID::kIce:
-	case RE::MATERIAL_ID::kSand:
-	case RE::MATERIAL_ID::kMud:
-		return nullptr;
-	default:
-		formID = LSnow02;
-		break;
-	}
 
-	return RE::TESForm::LookupByID<RE::TESLandTexture>(formID);
+		std::uint32_t LookupEditorID(std::string_view a_editorID) const override
+		{
+			const auto form = RE::TESForm::LookupByEditorID(a_editorID);
+			return form ? form->GetFormID() : 0;
+		}
+	};
+}
+
+FormSwapMap::SwapRuns FormSwapMap::ResolveFormSwaps(const FormSwapParser::Document& a_document)
+{
+	SwapRuns runs;
+	FormResolver::ResolveRuns(a_document, GameLoadOrder{}, runs);
+	return runs;
 }
 
-void FormSwapMap::LoadFormSwaps(const std::string& a_type, const std::vector<std::string>& a_values)
+void FormSwapMap::MergeFormSwaps(const SwapRuns& a_runs)
 {
-	auto& map = get_map(a_type);
-	for (const auto& key : a_values) {
-		const auto formPair = string::split(key, "|");
+	for (std::size_t i = 0; i < recordTypes.size(); ++i) {
+		const auto& run = a_runs[i];
+		if (run.empty()) {
+			continue;
+		}
 
-		const auto formID = INI::parse_form(formPair[kBase]);
-		const auto swapFormID = INI::parse_form(formPair[kSwap]);
+		logger::info("\t\t[{}] read {} variants", recordTypes[i], run.size());
 
-		if (formID != 0 && swapFormID != 0) {
+		auto& map = get_map(recordTypes[i]);
+		map.reserve(map.size() + run.size());
+		for (const auto& [formID, swapFormID] : run) {
 			map.insert_or_assign(formID, swapFormID);
 		}
 	}
 }
 
-void FormSwapMap::LoadFormSwaps(const CSimpleIniA& a_ini)
+void FormSwapMap::ExtractFormSwaps(std::size_t a_season, std::vector<SeasonSwaps::Entry>& a_entries)
 {
-	for (auto& type : recordTypes) {
-		CSimpleIniA::TNamesDepend values;
-		a_ini.GetAllKeys(type.c_str(), values);
-		values.sort(CSimpleIniA::Entry::LoadOrder());
-
-		if (!values.empty()) {
-			logger::info("\t\t[{}] read {} variants", type, values.size());
-
-			std::vector<std::string> vec;
-			std::ranges::transform(values, std::back_inserter(vec), [&](const auto& val) { return val.pItem; });
-
-			LoadFormSwaps(type, vec);
+	for (std::size_t i = 0; i < recordTypes.size(); ++i) {
+		auto& map = get_map(recordTypes[i]);
+		for (const auto& [formID, swapFormID] : map) {
+			a_entries.push_back({ formID, swapFormID, static_cast<std::uint8_t>(i), static_cast<std::uint8_t>(a_season) });
 		}
+		map = {};
 	}
 }
 
-//only covers winter
-bool FormSwapMap::GenerateFormSwaps(CSimpleIniA& a_ini, bool a_forceRegenerate)
+void FormSwapMap::InstallMainSwaps(const SwapRuns& a_runs)
 {
-	bool save = false;
+	auto table = std::make_unique<MainSwaps>();
+	for (std::size_t i = 0; i < a_runs.size(); ++i) {
+		const auto& run = a_runs[i];
+		if (run.empty()) {
+			continue;
+		}
 
-	for (auto& type : standardTypes) {
-		CSimpleIniA::TNamesDepend values;
-		a_ini.GetAllKeys(type.c_str(), values);
-		values.sort(CSimpleIniA::Entry::LoadOrder());
+		logger::info("\t\t[{}] read {} variants", recordTypes[i], run.size());
 
-		if (values.empty() || a_forceRegenerate) {
-			save = true;
+		if (!(*table)[i].Build(run)) {
+			logger::error("\t\t[{}] couldn't build a perfect hash table, falling back to a sorted table", recordTypes[i]);
+		}
+	}
 
-			if (a_forceRegenerate) {
-				a_ini.Delete(type.c_str(), nullptr, true);
-			}
+	std::scoped_lock locker(_mainSwapsLock);
+	_mainSwaps.store(table.get(), std::memory_order_release);
+	_mainSwapsStorage.push_back(std::move(table));
+}
 
-			switch (string::const_hash(type)) {
-			case string::const_hash("LandTextures"sv):
-				{
-					TempFormSwapMap<RE::TESLandTexture> landTxstMap;
-					get_snow_variants(a_ini, type, landTxstMap);
-				}
-				break;
-			case string::const_hash("Activators"sv):
-				{
-					TempFormSwapMap<RE::TESObjectACTI> activatorMap;
-					get_snow_variants(a_ini, type, activatorMap);
-				}
-				break;
-			case string::const_hash("Furniture"sv):
-				{
-					TempFormSwapMap<RE::TESFurniture> furnitureMap;
-					get_snow_variants(a_ini, type, furnitureMap);
-				}
-				break;
-			case string::const_hash("MovableStatics"sv):
-				{
-					TempFormSwapMap<RE::BGSMovableStatic> movStaticMap;
-					get_snow_variants(a_ini, type, movStaticMap);
-				}
-				break;
-			case string::const_hash("Statics"sv):
-				{
-					TempFormSwapMap<RE::TESObjectSTAT> staticMap;
-					get_snow_variants(a_ini, type, staticMap);
-				}
-				break;
-			case string::const_hash("Trees"sv):
-				{
-					TempFormSwapMap<RE::TESObjectTREE> treeMap;
-					get_snow_variants(a_ini, type, treeMap);
-				}
-				break;
-			default:
-				break;
+void FormSwapMap::GetMemoryStats(std::string_view a_season, std::vector<MemoryStats::Table>& a_tables)
+{
+	std::scoped_lock locker(_mainSwapsLock);
+	if (_mainSwapsStorage.empty()) {
+		return;
+	}
+
+	const auto         current = _mainSwaps.load(std::memory_order_acquire);
+	MemoryStats::Table retired{ std::format("{}::Main (retired)", a_season) };
+	for (const auto& table : _mainSwapsStorage) {
+		for (std::size_t i = 0; i < table->size(); ++i) {
+			auto stats = MemoryStats::GetTable(std::format("{}::Main{}", a_season, recordTypes[i]), (*table)[i]);
+			if (table.get() == current) {
+				a_tables.push_back(std::move(stats));
+			} else {
+				retired.entries += stats.entries;
+				retired.capacity += stats.capacity;
+				retired.buckets += stats.buckets;
+				retired.bytes += stats.bytes;
 			}
 		}
 	}
-
-	return save;
+	if (_mainSwapsStorage.size() > 1) {
+		a_tables.push_back(std::move(retired));
+	}
 }
 
-RE::TESBoundObject* FormSwapMap::GetSwapForm(const RE::TESForm* a_form)
+std::size_t FormSwapMap::get_index(RE::FormType a_formType)
 {
-	auto& map = get_map(a_form->GetFormType());
-	if (map.empty()) {
-		return nullptr;
+	switch (a_formType) {
+	case RE::FormType::LandTexture:
+		return 0;
+	case RE::FormType::Activator:
+		return 1;
+	case RE::FormType::Furniture:
+		return 2;
+	case RE::FormType::MovableStatic:
+		return 3;
+	case RE::FormType::Static:
+		return 4;
+	case RE::FormType::Tree:
+		return 5;
+	case RE::FormType::Flora:
+		return 6;
+	case RE::FormType::ReferenceEffect:
+		return 7;
+	default:
+		return std::tuple_size_v<SwapRuns>;
 	}
-
-	const auto it = map.find(a_form->GetFormID());
-	return it != map.end() ? RE::TESForm::LookupByID<RE::TESBoundObject>(it->second) : nullptr;
 }
 
-RE::TESLandTexture* FormSwapMap::GetSwapLandTexture(const RE::TESLandTexture* a_landTxst)
+RE::FormID FormSwapMap::get_main_swap(std::size_t a_index, RE::FormID a_formID) const
 {
-	const auto& map = _formMap["LandTextures"];
-	if (map.empty()) {
-		return nullptr;
+	const auto table = _mainSwaps.load(std::memory_order_acquire);
+	if (!table || a_index >= table->size()) {
+		return 0;
 	}
 
-	const auto it = map.find(a_landTxst->GetFormID());
-	return it != map.end() ? RE::TESForm::LookupByID<RE::TESLandTexture>(it->second) : nullptr;
+	return (*table)[a_index].find(a_formID);
 }
 
-RE::TESLandTexture* FormSwapMap::GetSwapLandTexture(const RE::BGSTextureSet* a_txst)
+//only covers winter
+FormSwapMap::GENERATED FormSwapMap::GenerateFormSwaps(const std::filesystem::path& a_path, bool a_forceRegenerate)
 {
-	const auto landTexture = Cache::DataHolder::GetSingleton()->GetLandTextureFromTextureSet(a_txst);
-	return GetSwapLandTexture(landTexture);
+	const auto& catalog = Cache::DataHolder::GetSingleton()->GetCatalog();
+
+	//read into memory rather than mapped, the file is replaced while the sections still point into it
+	std::string existingFile;
+	if (std::ifstream file(a_path, std::ios::binary); file) {
+		existingFile.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+	}
+
+	const auto sections = SwapGenerator::SplitSections(existingFile);
+
+	SwapGenerator::Regenerated regenerated;
+	bool                       save = false;
+
+	for (std::size_t i = 0; i < standardTypes.size(); ++i) {
+		const auto& type = standardTypes[i];
+
+		const auto it = std::ranges::find_if(sections, [&](const auto& a_section) { return string::iequals(a_section.name, type); });
+		const auto existing = it != sections.end() ? &*it : nullptr;
+
+		if (existing && existing->entries != 0 && !a_forceRegenerate) {
+			continue;
+		}
+
+		SwapGenerator::Stats stats;
+		auto                 swaps = SwapGenerator::GetSnowVariants(catalog, static_cast<FormCatalog::TYPE>(i), &stats);
+
+		logger::info("	[{}] : generated {} variants ({} allocations, {} KB peak)", type, swaps.size(), stats.allocations, stats.peakBytes / 1024);
+
+		//leave the section (and any hand edits) alone if regenerating wouldn't change it
+		if ((existing ? existing->hash : SwapGenerator::SectionHash{}.value()) == SwapGenerator::HashSection(catalog, swaps)) {
+			logger::info("	[{}] : unchanged", type);
+			continue;
+		}
+
+		logger::info("	[{}] : wrote {} variants", type, swaps.size());
+
+		regenerated[i] = std::move(swaps);
+		save = true;
+	}
+
+	if (!save) {
+		return GENERATED::kUnchanged;
+	}
+
+	//entries are streamed straight to the file instead of building the whole document in memory
+	const auto written = Persistence::Manager::GetSingleton()->WriteFile(a_path, [&](std::ostream& a_stream) {
+		SwapGenerator::WriteFile(a_stream, catalog, sections, regenerated);
+		return a_stream.good();
+	});
+
+	return written ? GENERATED::kWritten : GENERATED::kFailed;
 }
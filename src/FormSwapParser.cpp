@@ -0,0 +1,240 @@
+#include "FormSwapParser.h"
+
+#include <algorithm>
+#include <limits>
+
+#ifdef _WIN32
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace FormSwapParser
+{
+	namespace detail
+	{
+		constexpr bool is_space(char a_ch)
+		{
+			return a_ch == ' ' || a_ch == '\t' || a_ch == '\r' || a_ch == '\n';
+		}
+
+		constexpr std::string_view trim(std::string_view a_str)
+		{
+			while (!a_str.empty() && is_space(a_str.front())) {
+				a_str.remove_prefix(1);
+			}
+			while (!a_str.empty() && is_space(a_str.back())) {
+				a_str.remove_suffix(1);
+			}
+			return a_str;
+		}
+
+		constexpr char to_lower(char a_ch)
+		{
+			return a_ch >= 'A' && a_ch <= 'Z' ? static_cast<char>(a_ch + ('a' - 'A')) : a_ch;
+		}
+
+		constexpr bool iequals(std::string_view a_lhs, std::string_view a_rhs)
+		{
+			return std::ranges::equal(a_lhs, a_rhs, [](char a_l, char a_r) { return to_lower(a_l) == to_lower(a_r); });
+		}
+	}
+
+	void Document::clear()
+	{
+		entries.clear();
+		sectionSizes.clear();
+		worldspaces.clear();
+		malformed = 0;
+	}
+
+#ifdef _WIN32
+	MappedFile::MappedFile(const std::filesystem::path& a_path)
+	{
+		const auto file = ::CreateFileW(a_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return;
+		}
+		_file = file;
+
+		LARGE_INTEGER size{};
+		if (!::GetFileSizeEx(file, &size)) {
+			return;
+		}
+		_size = static_cast<std::size_t>(size.QuadPart);
+		if (_size == 0) {  // can't map an empty file
+			_opened = true;
+			return;
+		}
+
+		_mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!_mapping) {
+			return;
+		}
+
+		_view = static_cast<const char*>(::MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+		_opened = _view != nullptr;
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (_view) {
+			::UnmapViewOfFile(_view);
+		}
+		if (_mapping) {
+			::CloseHandle(_mapping);
+		}
+		if (_file) {
+			::CloseHandle(_file);
+		}
+	}
+#else
+	MappedFile::MappedFile(const std::filesystem::path& a_path)
+	{
+		const auto fd = ::open(a_path.c_str(), O_RDONLY);
+		if (fd < 0) {
+			return;
+		}
+
+		struct stat st{};
+		if (::fstat(fd, &st) == 0) {
+			_size = static_cast<std::size_t>(st.st_size);
+			if (_size == 0) {
+				_opened = true;
+			} else if (const auto view = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0); view != MAP_FAILED) {
+				_view = static_cast<const char*>(view);
+				_opened = true;
+			}
+		}
+
+		::close(fd);
+	}
+
+	MappedFile::~MappedFile()
+	{
+		if (_view) {
+			::munmap(const_cast<char*>(_view), _size);
+		}
+	}
+#endif
+
+	bool parse_hex(std::string_view a_str, std::uint32_t& a_value)
+	{
+		if (a_str.size() > 2 && a_str[0] == '0' && (a_str[1] == 'x' || a_str[1] == 'X')) {
+			a_str.remove_prefix(2);
+		}
+		if (a_str.empty() || a_str.size() > 8) {
+			return false;
+		}
+
+		std::uint32_t value = 0;
+		for (const auto ch : a_str) {
+			std::uint32_t digit;
+			if (ch >= '0' && ch <= '9') {
+				digit = ch - '0';
+			} else if (ch >= 'a' && ch <= 'f') {
+				digit = ch - 'a' + 10;
+			} else if (ch >= 'A' && ch <= 'F') {
+				digit = ch - 'A' + 10;
+			} else {
+				return false;
+			}
+			value = (value << 4) | digit;
+		}
+
+		a_value = value;
+		return true;
+	}
+
+	bool parse_form(std::string_view a_str, FormRef& a_ref)
+	{
+		a_str = detail::trim(a_str);
+		if (a_str.empty()) {
+			return false;
+		}
+
+		if (const auto pos = a_str.find('~'); pos != std::string_view::npos && a_str.find('~', pos + 1) == std::string_view::npos) {
+			a_ref.isEditorID = false;
+			a_ref.name = detail::trim(a_str.substr(pos + 1));
+			return !a_ref.name.empty() && parse_hex(detail::trim(a_str.substr(0, pos)), a_ref.localID);
+		}
+
+		a_ref.isEditorID = true;
+		a_ref.name = a_str;
+		a_ref.localID = 0;
+		return true;
+	}
+
+	void Parse(std::string_view a_data, std::span<const std::string_view> a_sections, Document& a_document)
+	{
+		constexpr auto worldspaceSection = std::numeric_limits<std::uint32_t>::max() - 1;
+		constexpr auto ignoredSection = std::numeric_limits<std::uint32_t>::max();
+
+		a_document.clear();
+		a_document.sectionSizes.resize(a_sections.size(), 0);
+		a_document.entries.reserve(static_cast<std::size_t>(std::ranges::count(a_data, '\n')) + 1);
+
+		if (a_data.starts_with(std::string_view{ "\xEF\xBB\xBF" })) {
+			a_data.remove_prefix(3);
+		}
+
+		auto section = ignoredSection;
+
+		while (!a_data.empty()) {
+			const auto eol = a_data.find('\n');
+			auto       line = detail::trim(a_data.substr(0, eol));
+			a_data.remove_prefix(eol == std::string_view::npos ? a_data.size() : eol + 1);
+
+			if (line.empty() || line.front() == ';' || line.front() == '#') {
+				continue;
+			}
+
+			if (line.front() == '[') {
+				section = ignoredSection;
+				if (const auto end = line.find(']'); end != std::string_view::npos) {
+					const auto name = detail::trim(line.substr(1, end - 1));
+					if (detail::iequals(name, std::string_view{ "Worldspaces" })) {
+						section = worldspaceSection;
+					} else if (const auto it = std::ranges::find_if(a_sections, [&](const auto& a_section) { return detail::iequals(name, a_section); }); it != a_sections.end()) {
+						section = static_cast<std::uint32_t>(std::distance(a_sections.begin(), it));
+					}
+				}
+				continue;
+			}
+
+			if (section == ignoredSection) {
+				continue;
+			}
+
+			if (const auto equals = line.find('='); equals != std::string_view::npos) {
+				line = detail::trim(line.substr(0, equals));
+			}
+
+			if (section == worldspaceSection) {
+				a_document.worldspaces.push_back(line);
+				continue;
+			}
+
+			const auto separator = line.find('|');
+			if (separator == std::string_view::npos) {
+				++a_document.malformed;
+				continue;
+			}
+
+			auto swap = line.substr(separator + 1);
+			swap = swap.substr(0, swap.find('|'));
+
+			Entry entry{ section };
+			if (!parse_form(line.substr(0, separator), entry.base) || !parse_form(swap, entry.swap)) {
+				++a_document.malformed;
+				continue;
+			}
+
+			a_document.entries.push_back(entry);
+			++a_document.sectionSizes[section];
+		}
+	}
+}
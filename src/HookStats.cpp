@@ -0,0 +1,357 @@
+#include "HookStats.h"
+
+namespace HookStats
+{
+#ifdef HOOK_STATS
+	namespace detail
+	{
+		// log2 buckets of nanoseconds, bucket i holds [2^(i-1), 2^i)
+		constexpr std::size_t bucketCount = 40;
+
+		using Counter = std::atomic<std::uint64_t>;
+
+		struct Counters
+		{
+			Counter                          calls{ 0 };
+			Counter                          hits{ 0 };
+			Counter                          total{ 0 };
+			std::array<Counter, bucketCount> buckets{};
+		};
+
+		// written only by the owning thread, so increments don't need to be atomic read-modify-writes
+		using Block = std::array<Counters, std::to_underlying(HOOK::kTotal)>;
+
+		void add(Counter& a_counter, std::uint64_t a_value)
+		{
+			a_counter.store(a_counter.load(std::memory_order_relaxed) + a_value, std::memory_order_relaxed);
+		}
+
+		class Registry
+		{
+		public:
+			static Registry& GetSingleton()
+			{
+				static Registry singleton;
+				return singleton;
+			}
+
+			//blocks are never freed, threads that touch hooks live as long as the game
+			Block& GetThreadBlock()
+			{
+				thread_local Block* block = [this] {
+					std::scoped_lock locker(_lock);
+					return _blocks.emplace_back(std::make_unique<Block>()).get();
+				}();
+				return *block;
+			}
+
+			template <class F>
+			void ForEachBlock(F&& a_func)
+			{
+				std::scoped_lock locker(_lock);
+				for (const auto& block : _blocks) {
+					a_func(*block);
+				}
+			}
+
+		private:
+			std::mutex                          _lock;
+			std::vector<std::unique_ptr<Block>> _blocks;
+		};
+
+		void add(CellCost& a_cost, HOOK a_hook, std::uint64_t a_elapsed, bool a_hit, bool a_doubleClone)
+		{
+			a_cost.total += a_elapsed;
+
+			switch (a_hook) {
+			case HOOK::kGetHandle:
+				a_cost.swaps += a_hit;
+				break;
+			case HOOK::kStaticsClone3D:
+			case HOOK::kOtherFormsClone3D:
+				++a_cost.classifications;
+				a_cost.doubleClones += a_doubleClone;
+				break;
+			default:
+				++a_cost.landLookups;
+				break;
+			}
+		}
+
+		void add(CellCost& a_cost, const CellCost& a_other)
+		{
+			a_cost.total += a_other.total;
+			a_cost.swaps += a_other.swaps;
+			a_cost.classifications += a_other.classifications;
+			a_cost.doubleClones += a_other.doubleClones;
+			a_cost.landLookups += a_other.landLookups;
+		}
+
+		//Space-Saving top-N: a new cell at capacity replaces the cheapest one and inherits its total as an error bound,
+		//so cells arriving one after another in a new grid build up cost instead of evicting each other from zero
+		class CellTable
+		{
+		public:
+			static CellTable& GetSingleton()
+			{
+				static CellTable singleton;
+				return singleton;
+			}
+
+			//charges are collected per thread and merged in batches, so hooks don't take the lock on every call
+			void Charge(RE::FormID a_cell, HOOK a_hook, std::uint64_t a_elapsed, bool a_hit, bool a_doubleClone, std::chrono::steady_clock::time_point a_now)
+			{
+				thread_local Pending pending{};
+
+				auto& cost = pending.cells.try_emplace(a_cell, CellCost{ a_cell }).first->second;
+				add(cost, a_hook, a_elapsed, a_hit, a_doubleClone);
+
+				if (++pending.charges >= flushCharges || a_now - pending.lastFlush >= flushInterval) {
+					Merge(pending);
+					pending.cells.clear();
+					pending.charges = 0;
+					pending.lastFlush = a_now;
+				}
+			}
+
+			std::vector<CellCost> GetCells()
+			{
+				std::scoped_lock locker(_lock);
+				return _heap;
+			}
+
+			//batches still pending on other threads are dropped when they are merged
+			void Clear()
+			{
+				std::scoped_lock locker(_lock);
+				_heap.clear();
+				_positions.clear();
+				++_epoch;
+			}
+
+		private:
+			static constexpr std::size_t capacity = 512;
+
+			static constexpr std::uint32_t flushCharges = 256;
+			static constexpr auto          flushInterval = 100ms;
+
+			struct Pending
+			{
+				Map<RE::FormID, CellCost>             cells;
+				std::uint32_t                         charges{ 0 };
+				std::chrono::steady_clock::time_point lastFlush{};
+				std::uint32_t                         epoch{ 0 };
+			};
+
+			void Merge(Pending& a_pending)
+			{
+				std::scoped_lock locker(_lock);
+
+				if (a_pending.epoch != _epoch) {
+					a_pending.epoch = _epoch;
+					return;
+				}
+
+				for (const auto& [cell, charged] : a_pending.cells) {
+					if (const auto it = _positions.find(cell); it != _positions.end()) {
+						const auto pos = it->second;
+						add(_heap[pos], charged);
+						sift_down(pos);  // totals only grow
+						continue;
+					}
+
+					if (_heap.size() < capacity) {
+						_positions.emplace(cell, static_cast<std::uint32_t>(_heap.size()));
+						_heap.push_back(charged);
+						sift_up(_heap.size() - 1);
+						continue;
+					}
+
+					auto& cheapest = _heap.front();
+					auto  cost = charged;
+					cost.total += cheapest.total;
+					cost.error = cheapest.total;
+					_positions.erase(cheapest.cell);
+					_positions.emplace(cell, 0);
+					cheapest = cost;
+					sift_down(0);
+				}
+			}
+
+			void swap_entries(std::size_t a_lhs, std::size_t a_rhs)
+			{
+				std::swap(_heap[a_lhs], _heap[a_rhs]);
+				_positions[_heap[a_lhs].cell] = static_cast<std::uint32_t>(a_lhs);
+				_positions[_heap[a_rhs].cell] = static_cast<std::uint32_t>(a_rhs);
+			}
+
+			void sift_up(std::size_t a_pos)
+			{
+				while (a_pos > 0) {
+					const auto parent = (a_pos - 1) / 2;
+					if (_heap[parent].total <= _heap[a_pos].total) {
+						return;
+					}
+					swap_entries(parent, a_pos);
+					a_pos = parent;
+				}
+			}
+
+			void sift_down(std::size_t a_pos)
+			{
+				while (true) {
+					auto smallest = a_pos;
+					for (const auto child : { a_pos * 2 + 1, a_pos * 2 + 2 }) {
+						if (child < _heap.size() && _heap[child].total < _heap[smallest].total) {
+							smallest = child;
+						}
+					}
+					if (smallest == a_pos) {
+						return;
+					}
+					swap_entries(a_pos, smallest);
+					a_pos = smallest;
+				}
+			}
+
+			//min-heap on total, with each cell's position in it, so evicting the cheapest cell and charging a tracked one are O(log capacity)
+			std::mutex                     _lock;
+			std::vector<CellCost>          _heap;
+			Map<RE::FormID, std::uint32_t> _positions;
+			std::uint32_t                  _epoch{ 0 };
+		};
+
+		std::uint64_t get_percentile(const std::array<std::uint64_t, bucketCount>& a_buckets, std::uint64_t a_calls, double a_percentile)
+		{
+			const auto    target = static_cast<std::uint64_t>(std::ceil(static_cast<double>(a_calls) * a_percentile));
+			std::uint64_t seen = 0;
+			for (std::size_t i = 0; i < a_buckets.size(); ++i) {
+				seen += a_buckets[i];
+				if (seen >= target) {
+					return std::uint64_t(1) << i;
+				}
+			}
+			return std::uint64_t(1) << (bucketCount - 1);
+		}
+	}
+
+	Scope::Scope(HOOK a_hook, player_cell_t) :
+		Scope(a_hook, RE::PlayerCharacter::GetSingleton()->GetParentCell())
+	{}
+
+	Scope::~Scope()
+	{
+		const auto now = std::chrono::steady_clock::now();
+		const auto elapsed = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(now - _start).count());
+
+		if (_charged) {
+			detail::CellTable::GetSingleton().Charge(_cell, _hook, elapsed, _hit, _doubleClone, now);
+		}
+
+		auto& counters = detail::Registry::GetSingleton().GetThreadBlock()[std::to_underlying(_hook)];
+		detail::add(counters.calls, 1);
+		detail::add(counters.total, elapsed);
+		if (_hit) {
+			detail::add(counters.hits, 1);
+		}
+		detail::add(counters.buckets[std::min<std::size_t>(std::bit_width(elapsed), detail::bucketCount - 1)], 1);
+	}
+
+	std::vector<Summary> GetSummary()
+	{
+		struct Merged
+		{
+			std::uint64_t                                  calls{ 0 };
+			std::uint64_t                                  hits{ 0 };
+			std::uint64_t                                  total{ 0 };
+			std::array<std::uint64_t, detail::bucketCount> buckets{};
+		};
+
+		std::array<Merged, std::to_underlying(HOOK::kTotal)> merged{};
+
+		detail::Registry::GetSingleton().ForEachBlock([&](const detail::Block& a_block) {
+			for (std::size_t i = 0; i < a_block.size(); ++i) {
+				const auto& counters = a_block[i];
+				merged[i].calls += counters.calls.load(std::memory_order_relaxed);
+				merged[i].hits += counters.hits.load(std::memory_order_relaxed);
+				merged[i].total += counters.total.load(std::memory_order_relaxed);
+				for (std::size_t j = 0; j < detail::bucketCount; ++j) {
+					merged[i].buckets[j] += counters.buckets[j].load(std::memory_order_relaxed);
+				}
+			}
+		});
+
+		std::vector<Summary> summary;
+		for (std::size_t i = 0; i < merged.size(); ++i) {
+			if (const auto& [calls, hits, total, buckets] = merged[i]; calls != 0) {
+				summary.push_back({ hookNames[i], calls, hits, detail::get_percentile(buckets, calls, 0.5), detail::get_percentile(buckets, calls, 0.99), total });
+			}
+		}
+		return summary;
+	}
+
+	//racy against hooks running on other threads, a few counts may survive the reset
+	void Reset()
+	{
+		detail::Registry::GetSingleton().ForEachBlock([](detail::Block& a_block) {
+			for (auto& counters : a_block) {
+				counters.calls.store(0, std::memory_order_relaxed);
+				counters.hits.store(0, std::memory_order_relaxed);
+				counters.total.store(0, std::memory_order_relaxed);
+				for (auto& bucket : counters.buckets) {
+					bucket.store(0, std::memory_order_relaxed);
+				}
+			}
+		});
+		detail::CellTable::GetSingleton().Clear();
+	}
+
+	std::vector<CellCost> GetWorstCells(std::size_t a_count)
+	{
+		auto cells = detail::CellTable::GetSingleton().GetCells();
+		const auto count = std::min(a_count, cells.size());
+		std::ranges::partial_sort(cells, cells.begin() + count, std::ranges::greater{}, &CellCost::total);
+		cells.resize(count);
+		return cells;
+	}
+#else
+	std::vector<Summary> GetSummary()
+	{
+		return {};
+	}
+
+	void Reset()
+	{}
+
+	std::vector<CellCost> GetWorstCells(std::size_t)
+	{
+		return {};
+	}
+#endif
+
+	std::vector<std::string> GetReport()
+	{
+		std::vector<std::string> report;
+		for (const auto& [name, calls, hits, p50, p99, total] : GetSummary()) {
+			const auto hitRate = 100.0 * static_cast<double>(hits) / static_cast<double>(calls);
+			report.push_back(std::format("{:<32} calls {:>10} | hits {:>5.1f}% | p50 <{:>7} ns | p99 <{:>7} ns | total {:>8.2f} ms", name, calls, hitRate, p50, p99, static_cast<double>(total) / 1e6));
+		}
+		return report;
+	}
+
+	std::vector<std::string> GetCellReport(std::size_t a_count)
+	{
+		std::vector<std::string> report;
+		for (const auto& [cellID, total, error, swaps, classifications, doubleClones, landLookups] : GetWorstCells(a_count)) {
+			std::string name;
+			if (const auto cell = RE::TESForm::LookupByID<RE::TESObjectCELL>(cellID)) {
+				name = edid::get_editorID(cell);
+				if (const auto coordinates = cell->IsExteriorCell() ? cell->GetCoordinates() : nullptr; name.empty() && coordinates) {
+					name = std::format("({}, {})", coordinates->cellX, coordinates->cellY);
+				}
+			}
+			report.push_back(std::format("[{:08X}] {:<32} total {:>8.2f} ms (+/- {:.2f}) | swaps {:>6} | classified {:>6} | double clones {:>5} | land lookups {:>7}", cellID, name, static_cast<double>(total) / 1e6, static_cast<double>(error) / 1e6, swaps, classifications, doubleClones, landLookups));
+		}
+		return report;
+	}
+}
@@ -0,0 +1,87 @@
+#include "Manifest.h"
+
+namespace Manifest
+{
+	std::optional<std::pair<FILE_TYPE, SEASON>> Manager::get_file_type(std::string_view a_stem)
+	{
+		if (string::icontains(a_stem, "MainFormSwap"sv)) {
+			if (string::iequals(a_stem, "MainFormSwap_WIN"sv)) {
+				return std::make_pair(FILE_TYPE::kMainSwap, SEASON::kWinter);
+			}
+			return std::nullopt;
+		}
+
+		const auto pos = a_stem.rfind('_');
+		if (pos == std::string_view::npos) {
+			return std::nullopt;
+		}
+
+		static constexpr std::array<std::pair<std::string_view, SEASON>, 4> seasonSuffixes{
+			std::make_pair("WIN"sv, SEASON::kWinter),
+			std::make_pair("SPR"sv, SEASON::kSpring),
+			std::make_pair("SUM"sv, SEASON::kSummer),
+			std::make_pair("AUT"sv, SEASON::kAutumn)
+		};
+
+		const auto suffix = a_stem.substr(pos + 1);
+		for (const auto& [seasonSuffix, season] : seasonSuffixes) {
+			if (string::iequals(suffix, seasonSuffix)) {
+				return std::make_pair(FILE_TYPE::kSeasonSwap, season);
+			}
+		}
+		if (string::iequals(suffix, "SNOW"sv) || string::iequals(suffix, "NOSNOW"sv)) {
+			return std::make_pair(FILE_TYPE::kSnowConfig, SEASON::kNone);
+		}
+
+		return std::nullopt;
+	}
+
+	void Manager::Scan()
+	{
+		_entries.clear();
+
+		//the non-throwing increment, the range-for one throws on a read error
+		std::error_code ec;
+		for (std::filesystem::directory_iterator it(R"(Data\Seasons)", ec), end; !ec && it != end; it.increment(ec)) {
+			const auto& dirEntry = *it;
+
+			std::error_code fileEc;
+			if (!dirEntry.is_regular_file(fileEc) || !string::iequals(dirEntry.path().extension().string(), ".ini"sv)) {
+				continue;
+			}
+			if (const auto fileType = get_file_type(dirEntry.path().stem().string())) {
+				const auto& [type, season] = *fileType;
+				const auto size = dirEntry.file_size(fileEc);
+				_entries.push_back({ dirEntry.path(), type, season, fileEc ? 0 : size });
+			}
+		}
+
+		if (ec) {
+			logger::error("Couldn't read Data/Seasons folder ({})", ec.message());
+		}
+
+		std::ranges::sort(_entries, {}, &Entry::path);
+
+		logger::info("Data/Seasons : {} season swap inis, {} snow inis, main WIN formswap {}",
+			GetFiles(FILE_TYPE::kSeasonSwap).size(),
+			GetFiles(FILE_TYPE::kSnowConfig).size(),
+			GetMainSwap() ? "found" : "not found");
+	}
+
+	std::vector<const Entry*> Manager::GetFiles(FILE_TYPE a_type) const
+	{
+		std::vector<const Entry*> result;
+		for (const auto& entry : _entries) {
+			if (entry.type == a_type) {
+				result.push_back(&entry);
+			}
+		}
+		return result;
+	}
+
+	const Entry* Manager::GetMainSwap() const
+	{
+		const auto it = std::ranges::find(_entries, FILE_TYPE::kMainSwap, &Entry::type);
+		return it != _entries.end() ? std::to_address(it) : nullptr;
+	}
+}
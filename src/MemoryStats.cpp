@@ -0,0 +1,47 @@
+#include "MemoryStats.h"
+
+#include "SeasonManager.h"
+#include "SnowSwap.h"
+
+namespace MemoryStats
+{
+	std::vector<Table> Collect()
+	{
+		std::vector<Table> tables;
+		Cache::DataHolder::GetSingleton()->GetMemoryStats(tables);
+		SnowSwap::Manager::GetSingleton()->GetMemoryStats(tables);
+		SeasonManager::GetSingleton()->GetMemoryStats(tables);
+		return tables;
+	}
+
+	std::vector<std::string> GetReport()
+	{
+		std::vector<std::string> report;
+
+		Table total{ "Total" };
+		for (const auto& [name, entries, capacity, buckets, bytes] : Collect()) {
+			total.entries += entries;
+			total.capacity += capacity;
+			total.buckets += buckets;
+			total.bytes += bytes;
+
+			//unused season sections
+			if (capacity == 0 && buckets == 0) {
+				continue;
+			}
+			report.push_back(std::format("{:<32} entries {:>8} / {:>8} | buckets {:>8} | {:>10.1f} KB", name, entries, capacity, buckets, static_cast<double>(bytes) / 1024.0));
+		}
+		report.push_back(std::format("{:<32} entries {:>8} / {:>8} | buckets {:>8} | {:>10.1f} KB", total.name, total.entries, total.capacity, total.buckets, static_cast<double>(total.bytes) / 1024.0));
+
+		return report;
+	}
+
+	void Log(std::string_view a_reason)
+	{
+		logger::info("{:*^30}", "MEMORY");
+		logger::info("{}", a_reason);
+		for (const auto& line : GetReport()) {
+			logger::info("\t{}", line);
+		}
+	}
+}
@@ -0,0 +1,58 @@
+#include "OriginalBases.h"
+
+#include <mutex>
+
+namespace OriginalBases
+{
+	std::uint32_t Tracker::Get(std::uint32_t a_ref) const
+	{
+		std::shared_lock locker(_lock);
+
+		const auto it = _originals.find(a_ref);
+		return it != _originals.end() ? it->second : 0;
+	}
+
+	void Tracker::Set(std::uint32_t a_ref, std::uint32_t a_base)
+	{
+		std::unique_lock locker(_lock);
+		_originals.emplace(a_ref, a_base);
+	}
+
+	std::uint32_t Tracker::Release(std::uint32_t a_ref)
+	{
+		std::unique_lock locker(_lock);
+
+		const auto it = _originals.find(a_ref);
+		if (it == _originals.end()) {
+			return 0;
+		}
+
+		const auto base = it->second;
+		_originals.erase(it);
+		return base;
+	}
+
+	std::size_t Tracker::size() const
+	{
+		std::shared_lock locker(_lock);
+		return _originals.size();
+	}
+
+	std::size_t Tracker::capacity() const
+	{
+		std::shared_lock locker(_lock);
+		return _originals.values().capacity();
+	}
+
+	std::size_t Tracker::bucket_count() const
+	{
+		std::shared_lock locker(_lock);
+		return _originals.bucket_count();
+	}
+
+	std::size_t Tracker::get_memory_usage() const
+	{
+		std::shared_lock locker(_lock);
+		return _originals.values().capacity() * sizeof(Map::value_type) + _originals.bucket_count() * sizeof(Map::bucket_type);
+	}
+}
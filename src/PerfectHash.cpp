@@ -0,0 +1,129 @@
+#include "PerfectHash.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+namespace PerfectHash
+{
+	namespace
+	{
+		constexpr std::size_t averageBucketSize = 4;
+		// slots per key, a little headroom keeps pilot searches short
+		constexpr double loadFactor = 0.94;
+
+		constexpr std::uint32_t maxSeeds = 16;
+	}
+
+	bool Map::Build(std::span<const value_type> a_pairs)
+	{
+		_size = a_pairs.size();
+		_pilots.clear();
+		_slots.clear();
+
+		if (a_pairs.empty()) {
+			_pilots.shrink_to_fit();
+			_slots.shrink_to_fit();
+			return true;
+		}
+
+		const auto bucketCount = std::max<std::size_t>(1, a_pairs.size() / averageBucketSize);
+		const auto slotCount = std::max(a_pairs.size(), static_cast<std::size_t>(static_cast<double>(a_pairs.size()) / loadFactor));
+
+		std::vector<std::uint64_t> hashes(a_pairs.size());
+		std::vector<std::uint32_t> order(a_pairs.size());
+		std::vector<std::uint32_t> bucketStarts(bucketCount + 1);
+		std::vector<std::uint32_t> buckets(bucketCount);
+		std::vector<std::size_t>   slots;
+
+		for (std::uint32_t seed = 0; seed < maxSeeds; ++seed) {
+			_seed = mix(seed);
+			_pilots.assign(bucketCount, 0);
+			_slots.assign(slotCount, {});
+
+			// counting sort of the keys by bucket
+			std::ranges::fill(bucketStarts, 0);
+			for (std::size_t i = 0; i < a_pairs.size(); ++i) {
+				hashes[i] = mix(a_pairs[i].first ^ _seed);
+				++bucketStarts[reduce(hashes[i] >> 32, bucketCount) + 1];
+			}
+			for (std::size_t i = 0; i < bucketCount; ++i) {
+				bucketStarts[i + 1] += bucketStarts[i];
+			}
+			{
+				auto next = bucketStarts;
+				for (std::uint32_t i = 0; i < a_pairs.size(); ++i) {
+					order[next[reduce(hashes[i] >> 32, bucketCount)]++] = i;
+				}
+			}
+
+			// largest buckets first, while most slots are still free
+			for (std::uint32_t i = 0; i < bucketCount; ++i) {
+				buckets[i] = i;
+			}
+			std::ranges::stable_sort(buckets, std::greater{}, [&](auto a_bucket) { return bucketStarts[a_bucket + 1] - bucketStarts[a_bucket]; });
+
+			bool built = true;
+			for (const auto bucket : buckets) {
+				const auto begin = order.begin() + bucketStarts[bucket];
+				const auto end = order.begin() + bucketStarts[bucket + 1];
+				if (begin == end) {
+					break;
+				}
+
+				bool placed = false;
+				for (std::uint32_t pilot = 0; pilot <= std::numeric_limits<std::uint16_t>::max() && !placed; ++pilot) {
+					slots.clear();
+					placed = std::all_of(begin, end, [&](auto a_index) {
+						const auto slot = get_slot(hashes[a_index], static_cast<std::uint16_t>(pilot));
+						if (_slots[slot].first != 0 || std::ranges::find(slots, slot) != slots.end()) {
+							return false;
+						}
+						slots.push_back(slot);
+						return true;
+					});
+					if (placed) {
+						_pilots[bucket] = static_cast<std::uint16_t>(pilot);
+					}
+				}
+
+				if (!placed) {
+					built = false;
+					break;
+				}
+
+				for (std::size_t i = 0; i < slots.size(); ++i) {
+					_slots[slots[i]] = a_pairs[begin[i]];
+				}
+			}
+
+			if (built) {
+				return true;
+			}
+		}
+
+		// every seed failed, which only happens with duplicate keys, so keep the last pair of each key like insert_or_assign
+		_pilots.clear();
+		_pilots.shrink_to_fit();
+		_slots.assign(a_pairs.begin(), a_pairs.end());
+		std::ranges::stable_sort(_slots, {}, &value_type::first);
+
+		auto out = _slots.begin();
+		for (auto it = _slots.begin(); it != _slots.end();) {
+			const auto next = std::find_if(it, _slots.end(), [&](const auto& a_pair) { return a_pair.first != it->first; });
+			*out++ = *std::prev(next);
+			it = next;
+		}
+		_slots.erase(out, _slots.end());
+		_slots.shrink_to_fit();
+		_size = _slots.size();
+
+		return false;
+	}
+
+	std::uint32_t Map::find_sorted(std::uint32_t a_key) const
+	{
+		const auto it = std::ranges::lower_bound(_slots, a_key, {}, &value_type::first);
+		return it != _slots.end() && it->first == a_key ? it->second : 0;
+	}
+}
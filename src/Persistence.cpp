@@ -0,0 +1,202 @@
+#include "Persistence.h"
+
+namespace Persistence
+{
+	//by the time static destructors run on exit the worker has already been terminated, joining it here can deadlock
+	Manager::~Manager()
+	{
+		if (_worker.joinable()) {
+			_worker.detach();
+		}
+	}
+
+	SI_Error Manager::LoadFile(CSimpleIniA& a_ini, const std::filesystem::path& a_path)
+	{
+		{
+			Locker locker(_lock);
+			if (const auto it = _latest.find(a_path.native()); it != _latest.end()) {
+				return a_ini.LoadData(it->second);
+			}
+		}
+		return a_ini.LoadFile(a_path.c_str());
+	}
+
+	void Manager::SaveFile(const CSimpleIniA& a_ini, const std::filesystem::path& a_path)
+	{
+		std::string data;
+		if (const auto rc = a_ini.Save(data, true); rc < 0) {
+			logger::error("Couldn't serialize {} ({})", a_path.string(), rc);
+			return;
+		}
+
+		{
+			Locker locker(_lock);
+			if (!_worker.joinable()) {
+				Start();
+			}
+			_latest.insert_or_assign(a_path.native(), std::move(data));
+			_dirty.insert(a_path.native());
+		}
+		_pendingCV.notify_one();
+	}
+
+	void Manager::Start()
+	{
+		_worker = std::thread(&Manager::Run, this);
+	}
+
+	void Manager::Flush()
+	{
+		WriteDirty();
+	}
+
+	bool Manager::WriteFile(const std::filesystem::path& a_path, const std::function<bool(std::ostream&)>& a_write)
+	{
+		auto tempPath = a_path;
+		tempPath += ".tmp";
+
+		std::error_code ec;
+
+		{
+			std::vector<char> buffer(1 << 16);
+			std::ofstream     stream;
+			stream.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+			stream.open(tempPath, std::ios::binary | std::ios::trunc);
+			if (!stream || !a_write(stream) || !stream.flush()) {
+				logger::error("Couldn't write {}", tempPath.string());
+				stream.close();
+				std::filesystem::remove(tempPath, ec);
+				return false;
+			}
+		}
+
+		std::filesystem::rename(tempPath, a_path, ec);
+		if (ec) {
+			logger::error("Couldn't replace {} ({})", a_path.string(), ec.message());
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+
+		return true;
+	}
+
+	void Manager::Run()
+	{
+		Locker locker(_lock);
+		while (true) {
+			_pendingCV.wait(locker, [this] { return !_dirty.empty(); });
+
+			// documents are often saved several times in a row during startup, only write the last one
+			_pendingCV.wait_for(locker, 100ms, [] { return false; });
+			locker.unlock();
+
+			WriteDirty();
+
+			locker.lock();
+		}
+	}
+
+	void Manager::WriteDirty()
+	{
+		std::scoped_lock writer(_writeLock);
+
+		std::vector<Document> documents;
+		{
+			Locker locker(_lock);
+			documents = TakeDirty();
+		}
+
+		WriteDocuments(documents);
+	}
+
+	std::vector<Manager::Document> Manager::TakeDirty()
+	{
+		//failed writes are retried along with whatever is written next
+		for (const auto& key : _failed) {
+			_dirty.insert(key);
+		}
+		_failed.clear();
+
+		std::vector<Document> documents;
+		documents.reserve(_dirty.size());
+		for (const auto& key : _dirty) {
+			if (const auto it = _latest.find(key); it != _latest.end()) {
+				documents.emplace_back(key, it->second);
+			}
+		}
+		_dirty.clear();
+
+		return documents;
+	}
+
+	void Manager::WriteDocuments(const std::vector<Document>& a_documents)
+	{
+		std::vector<bool> written;
+		written.reserve(a_documents.size());
+		for (const auto& document : a_documents) {
+			written.push_back(WriteDocument(document));
+		}
+
+		Locker locker(_lock);
+		for (std::size_t i = 0; i < a_documents.size(); ++i) {
+			const auto& key = a_documents[i].path.native();
+			if (_dirty.contains(key)) {
+				continue;
+			}
+			//keep serving the unwritten contents to LoadFile until a later write succeeds
+			if (written[i]) {
+				_latest.erase(key);
+			} else {
+				_failed.insert(key);
+			}
+		}
+	}
+
+	bool Manager::WriteDocument(const Document& a_document)
+	{
+		const auto& [path, data] = a_document;
+
+		const auto hash = GetHash(data);
+
+		auto it = _diskHashes.find(path.native());
+		if (it == _diskHashes.end()) {
+			std::string existing;
+			if (std::ifstream file(path, std::ios::binary); file) {
+				existing.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+			}
+			it = _diskHashes.emplace(path.native(), GetHash(existing)).first;
+		}
+
+		if (it->second == hash) {
+			return true;
+		}
+
+		auto tempPath = path;
+		tempPath += ".tmp";
+
+		{
+			std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+			if (!file || !file.write(data.data(), static_cast<std::streamsize>(data.size())) || !file.flush()) {
+				logger::error("Couldn't write {}", tempPath.string());
+				return false;
+			}
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(tempPath, path, ec);
+		if (ec) {
+			logger::error("Couldn't replace {} ({})", path.string(), ec.message());
+			std::filesystem::remove(tempPath, ec);
+			return false;
+		}
+
+		it->second = hash;
+
+		return true;
+	}
+
+	std::uint64_t Manager::GetHash(std::string_view a_data)
+	{
+		return ankerl::unordered_dense::hash<std::string_view>{}(a_data);
+	}
+}
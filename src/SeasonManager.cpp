@@ -1,5 +1,8 @@
 #include "SeasonManager.h"
+#include "Manifest.h"
 #include "Papyrus.h"
+#include "Persistence.h"
+#include "Trace.h"
 
 Season* SeasonManager::GetSeasonImpl(SEASON a_season)
 {
@@ -50,6 +53,8 @@ Season* SeasonManager::GetCurrentSeason(bool a_ignoreOverride)
 
 bool SeasonManager::UpdateSeason()
 {
+	Trace::Span span("UpdateSeason", "season");
+
 	bool shouldUpdate = false;
 
 	if (loadedFromSave) {
@@ -85,6 +90,14 @@ bool SeasonManager::UpdateSeason()
 		loadedFromSave = false;
 	}
 
+	if (shouldUpdate) {
+		auto change = std::format("{} -> {}", std::to_underlying(lastSeason), std::to_underlying(seasonOverride != SEASON::kNone ? seasonOverride : currentSeason));
+		MemoryStats::Log(std::format("Season changed ({})", change));
+		if (Trace::IsEnabled()) {
+			span.SetDetail(std::move(change));
+		}
+	}
+
 	return shouldUpdate;
 }
 
@@ -118,7 +131,7 @@ void SeasonManager::LoadSettings()
 	CSimpleIniA ini;
 	ini.SetUnicode();
 
-	ini.LoadFile(settings);
+	Persistence::Manager::GetSingleton()->LoadFile(ini, settings);
 
 	logger::info("{:*^30}", "SETTINGS");
 
@@ -139,6 +152,8 @@ void SeasonManager::LoadSettings()
 	ini::get_value(ini, seasonType, "Settings", "Season Type", ";0 - disabled\n;1 - permanent winter\n;2 - permanent spring\n;3 - permanent summer\n;4 - permanent autumn\n;5 - seasonal");
 
 	ini::get_value(ini, mainWINSwap.skip, "Winter", "Ignore auto generated WIN formswap", ";Autogenerated winter formswap config will not be applied.");
+	ini::get_value(ini, mainWINSwap.generate, "Winter", "Generate WIN formswap", ";Generate the winter formswap in game when the load order changes.\n;Disable if MainFormSwap_WIN.ini is precomputed with SeasonsSwapGenerator.");
+	ini::get_value(ini, mainWINSwap.exportCatalog, "Winter", "Export Form Catalog", ";Write Data/Seasons/FormCatalog.bin on startup, for SeasonsSwapGenerator.");
 	ini::get_value(ini, mainWINSwap.skipLT, "Winter", "Skip Land Textures", ";Skip loading these form types from autogenerated winter formswap.");
 	ini::get_value(ini, mainWINSwap.skipActi, "Winter", "Skip Activator", nullptr);
 	ini::get_value(ini, mainWINSwap.skipFurn, "Winter", "Skip Furniture", nullptr);
@@ -150,6 +165,20 @@ void SeasonManager::LoadSettings()
 
 	ini::get_value(ini, preferMultipass, "Settings", "Prefer Multipass", ";If true, multipass materials will be used where supported.\n;If false, single pass will be used instead.");
 
+	bool recordCalls = false;
+	ini::get_value(ini, recordCalls, "Settings", "Record Hook Calls", ";Log every form swap, static snow and land texture lookup to po3_SeasonsOfSkyrim.calls.bin in the log folder, for replaying outside the game.\n;The file grows by 16 bytes per call, only enable it for profiling sessions.");
+	if (const auto logDirectory = logger::log_directory(); recordCalls && logDirectory) {
+		if (const auto path = *logDirectory / std::format("{}.calls.bin", Version::PROJECT); CallTrace::Recorder::GetSingleton().Start(path)) {
+			logger::info("Recording hook calls to {}", path.string());
+		} else {
+			logger::error("Couldn't open {} for hook call recording", path.string());
+		}
+	}
+
+	bool exportTrace = false;
+	ini::get_value(ini, exportTrace, "Settings", "Export Trace", ";Write startup and season change timings to po3_SeasonsOfSkyrim.trace.json in the log folder.\n;Open it in chrome://tracing or ui.perfetto.dev.");
+	Trace::SetEnabled(exportTrace);
+
 	LoadMonthToSeasonMap(ini);
 
 	winter.LoadSettings(ini, true);
@@ -157,15 +186,15 @@ void SeasonManager::LoadSettings()
 	summer.LoadSettings(ini);
 	autumn.LoadSettings(ini);
 
-	(void)ini.SaveFile(settings);
+	Persistence::Manager::GetSingleton()->SaveFile(ini, settings);
 }
 
-bool SeasonManager::ShouldRegenerateWinterFormSwap() const
+std::optional<std::size_t> SeasonManager::ShouldRegenerateWinterFormSwap() const
 {
 	CSimpleIniA ini;
 	ini.SetUnicode();
 
-	ini.LoadFile(serializedSeasonList);
+	Persistence::Manager::GetSingleton()->LoadFile(ini, serializedSeasonList);
 
 #ifndef SKYRIMVR
 	const auto&  mods = RE::TESDataHandler::GetSingleton()->compiledFileCollection;
@@ -179,28 +208,78 @@ bool SeasonManager::ShouldRegenerateWinterFormSwap() const
 		actualModCount = RE::TESDataHandler::GetSingleton()->loadedModCount;
 	}
 #endif
-	//1.6.0 - delete old serialized value to force regeneration
-	ini.DeleteValue("Game", "Mod Count", nullptr);
-
 	const auto expectedModCount = string::to_num<size_t>(ini.GetValue("Game", "Total Mod Count", "0"));
 
-	const auto shouldRegenerate = actualModCount != expectedModCount;
+	const auto mainSwap = Manifest::Manager::GetSingleton()->GetMainSwap();
+	const auto missingMainSwap = !mainSwap || mainSwap->size == 0;
 
-	if (shouldRegenerate) {
-		ini.SetValue("Game", "Total Mod Count", std::to_string(actualModCount).c_str(), nullptr);
-		if (expectedModCount != 0) {
-			logger::info("Mod count has changed since last run ({} -> {}), regenerating main WIN formswap", expectedModCount, actualModCount);
-		} else {
-			logger::info("Regenerating main WIN formswap since last update");
-		}
-		(void)ini.SaveFile(serializedSeasonList);
+	const auto shouldRegenerate = actualModCount != expectedModCount || missingMainSwap;
+
+	if (!shouldRegenerate) {
+		return std::nullopt;
 	}
 
-	return shouldRegenerate;
+	if (missingMainSwap) {
+		logger::info("Main WIN formswap not found, generating");
+	} else if (expectedModCount != 0) {
+		logger::info("Mod count has changed since last run ({} -> {}), regenerating main WIN formswap", expectedModCount, actualModCount);
+	} else {
+		logger::info("Regenerating main WIN formswap since last update");
+	}
+
+	return actualModCount;
+}
+
+//only once the file is current, or an exit mid-generation would leave stale swaps that are never regenerated
+void SeasonManager::SaveWinterFormSwapModCount(std::size_t a_modCount) const
+{
+	std::scoped_lock locker(serializedSeasonListLock);
+
+	CSimpleIniA ini;
+	ini.SetUnicode();
+
+	const auto persistence = Persistence::Manager::GetSingleton();
+	persistence->LoadFile(ini, serializedSeasonList);
+
+	//1.6.0 - delete old serialized value to force regeneration
+	ini.DeleteValue("Game", "Mod Count", nullptr);
+	ini.SetValue("Game", "Total Mod Count", std::to_string(a_modCount).c_str(), nullptr);
+
+	persistence->SaveFile(ini, serializedSeasonList);
+	persistence->Flush();
+}
+
+bool SeasonManager::IsWinterFormSwapSkipped(std::string_view a_type) const
+{
+	switch (string::const_hash(a_type)) {
+	case string::const_hash("LandTextures"sv):
+		return mainWINSwap.skipLT;
+	case string::const_hash("Activators"sv):
+		return mainWINSwap.skipActi;
+	case string::const_hash("Furniture"sv):
+		return mainWINSwap.skipFurn;
+	case string::const_hash("MovableStatics"sv):
+		return mainWINSwap.skipMovStat;
+	case string::const_hash("Statics"sv):
+		return mainWINSwap.skipStat;
+	case string::const_hash("Trees"sv):
+		return mainWINSwap.skipTree;
+	default:
+		return false;
+	}
 }
 
 void SeasonManager::LoadOrGenerateWinterFormSwap()
 {
+	if (mainWINSwap.exportCatalog) {
+		constexpr auto catalogPath = L"Data/Seasons/FormCatalog.bin";
+		if (std::ofstream stream(catalogPath, std::ios::binary | std::ios::trunc); stream && Cache::DataHolder::GetSingleton()->GetCatalog().Save(stream)) {
+			logger::info("Exported form catalog to Data/Seasons/FormCatalog.bin");
+		} else {
+			logger::error("Couldn't export form catalog to Data/Seasons/FormCatalog.bin");
+		}
+	}
+
 	if (mainWINSwap.skip) {
 		logger::info("Main WIN formswap loading disabled in config");
 		return;
@@ -210,127 +289,138 @@ void SeasonManager::LoadOrGenerateWinterFormSwap()
 
 	logger::info("Loading main WIN formswap settings");
 
-	CSimpleIniA ini;
-	ini.SetUnicode();
-	ini.SetMultiKey();
-	ini.SetAllowKeyOnly();
-
-	ini.LoadFile(path);
-
 	auto& winFormSwapMap = winter.GetFormSwapMap();
 
-	if (winFormSwapMap.GenerateFormSwaps(ini, ShouldRegenerateWinterFormSwap())) {
-		(void)ini.SaveFile(path);
-	} else {
-		for (auto& type : FormSwapMap::standardTypes) {
-			switch (string::const_hash(type)) {
-			case string::const_hash("LandTextures"sv):
-				{
-					if (mainWINSwap.skipLT) {
-						logger::info("\t[{}] skipping...", type);
-						continue;
-					}
-				}
-				break;
-			case string::const_hash("Activators"sv):
-				{
-					if (mainWINSwap.skipActi) {
-						logger::info("\t[{}] skipping...", type);
-						continue;
-					}
-				}
-				break;
-			case string::const_hash("Furniture"sv):
-				{
-					if (mainWINSwap.skipFurn) {
-						logger::info("\t[{}] skipping...", type);
-						continue;
-					}
-				}
-				break;
-			case string::const_hash("MovableStatics"sv):
-				{
-					if (mainWINSwap.skipMovStat) {
-						logger::info("\t[{}] skipping...", type);
-						continue;
-					}
-				}
-				break;
-			case string::const_hash("Statics"sv):
-				{
-					if (mainWINSwap.skipStat) {
-						logger::info("\t[{}] skipping...", type);
-						continue;
-					}
-				}
-				break;
-			case string::const_hash("Trees"sv):
-				{
-					if (mainWINSwap.skipTree) {
-						logger::info("\t[{}] skipping...", type);
-						continue;
-					}
-				}
-				break;
-			default:
-				break;
+	const auto load_form_swaps = [this, &winFormSwapMap](const FormSwapParser::Document& a_document) {
+		auto runs = FormSwapMap::ResolveFormSwaps(a_document);
+		for (std::size_t i = 0; i < FormSwapMap::standardTypes.size(); ++i) {
+			if (const auto& type = FormSwapMap::standardTypes[i]; IsWinterFormSwapSkipped(type)) {
+				logger::info("\t[{}] skipping...", type);
+				runs[i].clear();
 			}
+		}
+		winFormSwapMap.InstallMainSwaps(runs);
+	};
 
-			CSimpleIniA::TNamesDepend values;
-			ini.GetAllKeys(type.c_str(), values);
-			values.sort(CSimpleIniA::Entry::LoadOrder());
+	const auto modCount = mainWINSwap.generate ? ShouldRegenerateWinterFormSwap() : std::nullopt;
+	const auto regenerate = modCount.has_value();
+
+	FormSwapParser::Document document;
+
+	//fast path, every section has already been generated
+	if (const FormSwapParser::MappedFile file(path); file.is_open()) {
+		FormSwapParser::Parse(file.data(), FormSwapMap::recordTypeNames, document);
+		if (!regenerate && (!mainWINSwap.generate || std::all_of(document.sectionSizes.begin(), document.sectionSizes.begin() + FormSwapMap::standardTypes.size(), [](auto a_size) { return a_size != 0; }))) {
+			load_form_swaps(document);
+			return;
+		}
+		//stale or incomplete, but still better than nothing until generation is done
+		if (!document.entries.empty()) {
+			logger::info("\tUsing existing main WIN formswap until generation is finished");
+			load_form_swaps(document);
+		}
+	} else if (!mainWINSwap.generate) {
+		logger::info("Main WIN formswap not found and in-game generation is disabled");
+		return;
+	}
 
-			if (!values.empty()) {
-				logger::info("\t[{}] read {} variants", type, values.size());
+	//catalog is immutable after kDataLoaded, and the previous table stays installed until this one is ready
+	mainSwapTask = std::async(std::launch::async, [this, path, regenerate, modCount, load_form_swaps]() {
+		Trace::Span span("GenerateWinterFormSwap", "worker");
 
-				std::vector<std::string> vec;
-				std::ranges::transform(values, std::back_inserter(vec), [&](const auto& val) { return val.pItem; });
+		//get() runs in the SetInterior hook, so a failure is logged here and the installed table is kept
+		try {
+			const auto startTime = std::chrono::steady_clock::now();
 
-				winFormSwapMap.LoadFormSwaps(type, vec);
+			const auto result = FormSwapMap::GenerateFormSwaps(path, regenerate);
+			if (result == FormSwapMap::GENERATED::kFailed) {
+				logger::error("Couldn't generate main WIN formswap, it will be regenerated on next launch");
+				return;
 			}
+
+			if (modCount) {
+				SaveWinterFormSwapModCount(*modCount);
+			}
+
+			//nothing changed, so whatever was installed from the existing file is already current
+			if (result == FormSwapMap::GENERATED::kUnchanged) {
+				logger::info("Main WIN formswap is up to date");
+				return;
+			}
+
+			const FormSwapParser::MappedFile file(path);
+			if (!file.is_open()) {
+				logger::error("Couldn't read generated main WIN formswap");
+				return;
+			}
+
+			FormSwapParser::Document document;
+			FormSwapParser::Parse(file.data(), FormSwapMap::recordTypeNames, document);
+			load_form_swaps(document);
+
+			const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+			logger::info("Generated main WIN formswap in {} ms", elapsed.count());
+		} catch (const std::exception& e) {
+			logger::error("Couldn't generate main WIN formswap ({}), keeping the installed one", e.what());
 		}
-	}
+	});
 }
 
-void SeasonManager::LoadSeasonData(Season& a_season, CSimpleIniA& a_settings)
+void SeasonManager::WaitForWinterFormSwap()
 {
-	std::vector<std::string> configs;
+	if (!mainSwapTask.valid()) {
+		return;
+	}
 
+	if (mainSwapTask.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+		Trace::Span span("WaitForWinterFormSwap");
+
+		const auto startTime = std::chrono::steady_clock::now();
+		mainSwapTask.wait();
+		const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+		logger::info("Waited {} ms for main WIN formswap generation", elapsed.count());
+	}
+
+	mainSwapTask.get();
+
+	//generation span is only complete now
+	Trace::Write();
+}
+
+void SeasonManager::LoadSeasonData(Season& a_season, const std::vector<const Manifest::Entry*>& a_configs, std::vector<std::optional<Season::ConfigData>>& a_configData, CSimpleIniA& a_settings)
+{
 	const auto& [type, suffix] = a_season.GetID();
 
 	logger::info("{}", type);
 
-	for (constexpr auto folder = R"(Data\Seasons)"; const auto& entry : std::filesystem::directory_iterator(folder)) {
-		if (entry.exists() && !entry.path().empty() && entry.path().extension() == ".ini"sv) {
-			if (const auto path = entry.path().string(); path.contains(suffix) && !path.contains("MainFormSwap"sv)) {
-				configs.push_back(path);
-			}
-		}
-	}
+	const auto matchingConfigs = std::ranges::count(a_configs, a_season.GetType(), &Manifest::Entry::season);
 
-	if (configs.empty()) {
+	if (matchingConfigs == 0) {
 		logger::warn("\tNo .ini files with _{} suffix were found in Data/Seasons folder, skipping {} formswaps", suffix, suffix == "WIN" ? "secondary" : "all");
 		return;
 	}
 
-	logger::info("\t{} matching inis found", configs.size());
-
-	std::ranges::sort(configs);
+	logger::info("\t{} matching inis found", matchingConfigs);
 
-	for (auto& path : configs) {
-		logger::info("\tINI : {}", path);
+	//merge in sorted filename order so later files still override earlier ones
+	for (std::size_t i = 0; i < a_configs.size(); ++i) {
+		if (a_configs[i]->season != a_season.GetType()) {
+			continue;
+		}
 
-		CSimpleIniA ini;
-		ini.SetUnicode();
-		ini.SetMultiKey();
-		ini.SetAllowKeyOnly();
+		logger::info("\tINI : {}", a_configs[i]->path.string());
 
-		if (const auto rc = ini.LoadFile(path.c_str()); rc < 0) {
+		if (!a_configData[i]) {
 			logger::error("\t\tcouldn't read INI");
 			continue;
 		}
 
-		a_season.LoadData(ini);
+		if (const auto malformed = a_configData[i]->malformed; malformed != 0) {
+			logger::warn("\t\tskipped {} malformed entries", malformed);
+		}
+
+		a_season.LoadData(*a_configData[i]);
+		a_configData[i].reset();
 	}
 
 	//save worldspaces to settings so DynDOLOD can read them
@@ -342,14 +432,39 @@ void SeasonManager::LoadSeasonData()
 	CSimpleIniA settingsINI;
 	settingsINI.SetUnicode();
 
-	settingsINI.LoadFile(settings);
+	Persistence::Manager::GetSingleton()->LoadFile(settingsINI, settings);
+
+	const auto configs = Manifest::Manager::GetSingleton()->GetFiles(Manifest::FILE_TYPE::kSeasonSwap);
+
+	//parse and resolve every season config up front, on worker threads
+	const auto startTime = std::chrono::steady_clock::now();
+
+	std::vector<std::optional<Season::ConfigData>> configData(configs.size());
+	std::vector<std::size_t>                       indices(configs.size());
+	std::iota(indices.begin(), indices.end(), 0);
+
+	std::for_each(std::execution::par, indices.begin(), indices.end(), [&](std::size_t a_index) {
+		configData[a_index] = Season::ParseConfig(configs[a_index]->path);
+	});
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+	logger::info("Parsed {} season inis in {} ms", configs.size(), elapsed.count());
+
+	LoadSeasonData(winter, configs, configData, settingsINI);
+	LoadSeasonData(spring, configs, configData, settingsINI);
+	LoadSeasonData(summer, configs, configData, settingsINI);
+	LoadSeasonData(autumn, configs, configData, settingsINI);
+
+	//one row per base form, so the same rows stay warm when the season changes
+	std::vector<SeasonSwaps::Entry> entries;
+	for (auto* season : { &winter, &spring, &summer, &autumn }) {
+		season->GetFormSwapMap().ExtractFormSwaps(std::to_underlying(season->GetType()) - 1, entries);
+	}
+	seasonSwaps.Build(entries);
 
-	LoadSeasonData(winter, settingsINI);
-	LoadSeasonData(spring, settingsINI);
-	LoadSeasonData(summer, settingsINI);
-	LoadSeasonData(autumn, settingsINI);
+	logger::info("Combined {} season swaps into {} rows", entries.size(), seasonSwaps.size());
 
-	(void)settingsINI.SaveFile(settings);
+	Persistence::Manager::GetSingleton()->SaveFile(settingsINI, settings);
 }
 
 void SeasonManager::CheckLODExists()
@@ -362,61 +477,118 @@ void SeasonManager::CheckLODExists()
 	autumn.CheckLODExists();
 }
 
-void SeasonManager::SaveSeason(std::string_view a_savePath)
+void SeasonManager::Save(SKSE::SerializationInterface* a_intfc, std::uint32_t a_version)
 {
-	if (const auto player = RE::PlayerCharacter::GetSingleton(); !player->parentCell || !player->parentCell->IsExteriorCell()) {
+	if (const auto player = RE::PlayerCharacter::GetSingleton(); player->parentCell && player->parentCell->IsExteriorCell()) {
+		const auto season = GetCurrentSeason(true);
+		currentSeason = season ? season->GetType() : SEASON::kNone;
+	}
+
+	if (!a_intfc->OpenRecord(kSeasonState, a_version)) {
+		logger::error("Failed to open season state record");
 		return;
 	}
 
-	CSimpleIniA ini;
-	ini.SetUnicode();
+	a_intfc->WriteRecordData(currentSeason);
+	a_intfc->WriteRecordData(seasonOverride);
+}
 
-	ini.LoadFile(serializedSeasonList);
+void SeasonManager::Load(SKSE::SerializationInterface* a_intfc)
+{
+	SEASON season{};
+	SEASON overrideSeason{};
 
-	const auto season = GetCurrentSeason(true);
-	currentSeason = season ? season->GetType() : SEASON::kNone;
+	if (!a_intfc->ReadRecordData(season) || !a_intfc->ReadRecordData(overrideSeason)) {
+		logger::error("Failed to read season state record");
+		return;
+	}
 
-	const auto seasonData = std::format("{}|{}", std::to_underlying(currentSeason), std::to_underlying(seasonOverride));
-	ini.SetValue("Saves", a_savePath.data(), seasonData.c_str(), nullptr);
+	currentSeason = season;
+	seasonOverride = overrideSeason;
 
-	(void)ini.SaveFile(serializedSeasonList);
+	loadedFromSave = true;
 }
 
-void SeasonManager::LoadSeason(const std::string& a_savePath)
+void SeasonManager::SaveSeason(std::string_view a_savePath)
 {
-	CSimpleIniA ini;
-	ini.SetUnicode();
+	WaitForSerializedSeasonList();
 
-	ini.LoadFile(serializedSeasonList);
+	//season state is written to the cosave, drop the old entry
+	if (legacySeasons.erase(std::string(a_savePath)) != 0) {
+		SaveLegacySeasonList();
+	}
+}
 
-	const auto seasonData = string::split(ini.GetValue("Saves", a_savePath.c_str(), "3"), "|");
-	if (seasonData.size() == 2) {
-		currentSeason = string::to_num<SEASON>(seasonData[0]);
-		seasonOverride = string::to_num<SEASON>(seasonData[1]);
+void SeasonManager::LoadSeason(const std::string& a_savePath)
+{
+	WaitForSerializedSeasonList();
+
+	//cosave record (if any) is read after this and takes priority
+	if (const auto it = legacySeasons.find(a_savePath); it != legacySeasons.end()) {
+		std::tie(currentSeason, seasonOverride) = it->second;
 	} else {
-		currentSeason = string::to_num<SEASON>(seasonData[0]);
+		currentSeason = SEASON::kSummer;
 		seasonOverride = SEASON::kNone;
 	}
 
 	loadedFromSave = true;
+}
 
-	(void)ini.SaveFile(serializedSeasonList);
+void SeasonManager::ClearSeason(std::string_view a_savePath)
+{
+	WaitForSerializedSeasonList();
+
+	if (legacySeasons.erase(std::string(a_savePath)) != 0) {
+		SaveLegacySeasonList();
+	}
 }
 
-void SeasonManager::ClearSeason(std::string_view a_savePath) const
+void SeasonManager::SaveLegacySeasonList() const
 {
+	std::scoped_lock locker(serializedSeasonListLock);
+
 	CSimpleIniA ini;
 	ini.SetUnicode();
 
-	ini.LoadFile(serializedSeasonList);
+	Persistence::Manager::GetSingleton()->LoadFile(ini, serializedSeasonList);
+
+	ini.Delete("Saves", nullptr, true);
+	for (const auto& [save, seasonData] : legacySeasons) {
+		const auto value = std::format("{}|{}", std::to_underlying(seasonData.first), std::to_underlying(seasonData.second));
+		ini.SetValue("Saves", save.c_str(), value.c_str(), nullptr);
+	}
 
-	ini.DeleteValue("Saves", a_savePath.data(), nullptr);
+	Persistence::Manager::GetSingleton()->SaveFile(ini, serializedSeasonList);
+}
 
-	(void)ini.SaveFile(serializedSeasonList);
+namespace
+{
+	//"season|override", the override is optional
+	std::optional<std::pair<SEASON, SEASON>> parse_legacy_season(std::string_view a_value)
+	{
+		constexpr auto parse = [](std::string_view a_str) -> std::optional<SEASON> {
+			std::uint32_t value = 0;
+			const auto [ptr, ec] = std::from_chars(a_str.data(), a_str.data() + a_str.size(), value);
+			if (ec != std::errc{} || ptr != a_str.data() + a_str.size() || value > std::to_underlying(SEASON::kAutumn)) {
+				return std::nullopt;
+			}
+			return static_cast<SEASON>(value);
+		};
+
+		const auto separator = a_value.find('|');
+		const auto season = parse(a_value.substr(0, separator));
+		const auto overrideSeason = separator != std::string_view::npos ? parse(a_value.substr(separator + 1)) : SEASON::kNone;
+		if (!season || !overrideSeason) {
+			return std::nullopt;
+		}
+		return std::make_pair(*season, *overrideSeason);
+	}
 }
 
-void SeasonManager::CleanupSerializedSeasonList() const
+void SeasonManager::CleanupSerializedSeasonList()
 {
+	logger::info("{:*^30}", "SAVES");
+
 	constexpr auto get_save_directory = []() -> std::optional<std::filesystem::path> {
 		if (auto path = logger::log_directory()) {
 			path->remove_filename();  // remove "/SKSE"
@@ -426,40 +598,107 @@ void SeasonManager::CleanupSerializedSeasonList() const
 		return std::nullopt;
 	};
 
-	const auto directory = get_save_directory();
-	if (!directory) {
-		return;
+	auto directory = get_save_directory();
+	if (directory) {
+		logger::info("Save directory is {}", directory->string());
 	}
 
-	logger::info("{:*^30}", "SAVES");
+	//committed by WaitForSerializedSeasonList before the first save/load/delete message is handled
+	legacySeasonsTask = std::async(std::launch::async, [this, directory = std::move(directory)]() {
+		//get() is called in the save/load/delete message handlers, so nothing may be rethrown there
+		try {
+			return ReadSerializedSeasonList(directory);
+		} catch (const std::exception& e) {
+			logger::error("Couldn't read serialized season list ({})", e.what());
+			return LegacySeasonList{};
+		}
+	});
+}
+
+SeasonManager::LegacySeasonList SeasonManager::ReadSerializedSeasonList(const std::optional<std::filesystem::path>& a_directory) const
+{
+	Trace::Span span("PruneSerializedSeasonList", "worker");
+
+	const auto startTime = std::chrono::steady_clock::now();
 
-	logger::info("Save directory is {}", directory->string());
+	LegacySeasonList result;
 
 	CSimpleIniA ini;
 	ini.SetUnicode();
 
-	if (const auto rc = ini.LoadFile(serializedSeasonList); rc < 0) {
-		return;
+	if (const auto rc = Persistence::Manager::GetSingleton()->LoadFile(ini, serializedSeasonList); rc < 0) {
+		return result;
 	}
 
 	CSimpleIniA::TNamesDepend values;
 	ini.GetAllKeys("Saves", values);
-	values.sort(CSimpleIniA::Entry::LoadOrder());
-
-	if (!values.empty()) {
-		std::vector<std::string> badSaves;
-		badSaves.reserve(values.size());
-		for (const auto& key : values) {
-			if (auto save = std::format("{}{}.ess", directory->string(), key.pItem); !std::filesystem::exists(save)) {
-				badSaves.emplace_back(key.pItem);
+
+	if (values.empty()) {
+		return result;
+	}
+
+	result.saves.reserve(values.size());
+	for (const auto& key : values) {
+		if (const auto seasonData = parse_legacy_season(ini.GetValue("Saves", key.pItem, "3"))) {
+			result.saves.insert_or_assign(key.pItem, *seasonData);
+		} else {
+			++result.malformed;
+		}
+	}
+
+	if (a_directory) {
+		Set<std::string> existingSaves;
+		std::error_code  ec;
+		//the non-throwing increment, a read error midway leaves ec set so a partial listing never prunes saves
+		for (std::filesystem::directory_iterator it(*a_directory, ec), end; !ec && it != end; it.increment(ec)) {
+			const auto& entry = *it;
+			if (entry.path().extension() != ".ess"sv) {
+				continue;
+			}
+			try {
+				existingSaves.insert(string::tolower(entry.path().stem().string()));
+			} catch (...) {
+				logger::warn("\tSkipping save with unrepresentable name");
 			}
 		}
-		for (auto& badSave : badSaves) {
-			ini.DeleteValue("Saves", badSave.c_str(), nullptr);
+
+		if (ec) {
+			logger::error("\tCouldn't read save directory ({})", ec.message());
+		} else {
+			std::vector<std::string> badSaves;
+			for (const auto& save : result.saves | std::views::keys) {
+				if (!existingSaves.contains(string::tolower(save))) {
+					badSaves.push_back(save);
+				}
+			}
+			for (const auto& badSave : badSaves) {
+				result.saves.erase(badSave);
+			}
+			result.pruned = badSaves.size();
 		}
 	}
 
-	(void)ini.SaveFile(serializedSeasonList);
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+	if (result.malformed != 0) {
+		logger::warn("\tSkipped {} malformed saves", result.malformed);
+	}
+	logger::info("Pruned {} missing saves ({} pending migration to cosave) in {} ms", result.pruned, result.saves.size(), elapsed.count());
+
+	return result;
+}
+
+void SeasonManager::WaitForSerializedSeasonList()
+{
+	if (!legacySeasonsTask.valid()) {
+		return;
+	}
+
+	auto [saves, pruned] = legacySeasonsTask.get();
+	legacySeasons = std::move(saves);
+
+	if (pruned != 0) {
+		SaveLegacySeasonList();
+	}
 }
 
 SEASON SeasonManager::GetCurrentSeasonType()
@@ -504,22 +743,53 @@ bool SeasonManager::CanSwapGrass()
 	return season ? season->CanSwapForm(RE::FormType::Grass) : false;
 }
 
+RE::FormID SeasonManager::GetSwapFormID(Season* a_season, RE::FormType a_formType, RE::FormID a_formID) const
+{
+	if (!a_season) {
+		return 0;
+	}
+
+	const auto index = FormSwapMap::get_index(a_formType);
+	if (const auto swapFormID = seasonSwaps.find(index, std::to_underlying(a_season->GetType()) - 1, a_formID); swapFormID != 0) {
+		return swapFormID;
+	}
+	return a_season->GetFormSwapMap().get_main_swap(index, a_formID);
+}
+
 RE::TESBoundObject* SeasonManager::GetSwapForm(const RE::TESForm* a_form)
 {
-	const auto season = GetSeason();
-	return season ? season->GetFormSwapMap().GetSwapForm(a_form) : nullptr;
+	const auto swapFormID = GetSwapFormID(GetSeason(), a_form->GetFormType(), a_form->GetFormID());
+	return swapFormID != 0 ? RE::TESForm::LookupByID<RE::TESBoundObject>(swapFormID) : nullptr;
 }
 
 RE::TESLandTexture* SeasonManager::GetSwapLandTexture(const RE::TESLandTexture* a_landTxst)
 {
-	const auto season = GetSeason();
-	return season ? season->GetFormSwapMap().GetSwapLandTexture(a_landTxst) : nullptr;
+	const auto swapFormID = GetSwapFormID(GetSeason(), RE::FormType::LandTexture, a_landTxst->GetFormID());
+	return swapFormID != 0 ? RE::TESForm::LookupByID<RE::TESLandTexture>(swapFormID) : nullptr;
 }
 
 RE::TESLandTexture* SeasonManager::GetSwapLandTexture(const RE::BGSTextureSet* a_txst)
 {
-	const auto season = GetSeason();
-	return season ? season->GetFormSwapMap().GetSwapLandTexture(a_txst) : nullptr;
+	const auto landTexture = Cache::DataHolder::GetSingleton()->GetLandTextureFromTextureSet(a_txst);
+	return landTexture ? GetSwapLandTexture(landTexture) : nullptr;
+}
+
+void SeasonManager::RecordCall(CallTrace::HOOK a_hook, RE::FormID a_form, RE::FormID a_base)
+{
+	const auto worldSpace = RE::TES::GetSingleton()->worldSpace;
+	CallTrace::Recorder::GetSingleton().Record({ a_hook, static_cast<std::uint8_t>(GetSeasonType()), 0, worldSpace ? worldSpace->GetFormID() : 0, a_form, a_base });
+}
+
+void SeasonManager::GetMemoryStats(std::vector<MemoryStats::Table>& a_tables)
+{
+	for (auto* season : { &winter, &spring, &summer, &autumn }) {
+		season->GetFormSwapMap().GetMemoryStats(season->GetID().type, a_tables);
+	}
+
+	for (std::size_t i = 0; i < SeasonSwaps::typeCount; ++i) {
+		const auto size = seasonSwaps.size(i);
+		a_tables.push_back({ std::format("Seasons::{}", FormSwapMap::recordTypes[i]), size, size, 0, seasonSwaps.get_memory_usage(i) });
+	}
 }
 
 bool SeasonManager::GetExterior()
@@ -562,7 +832,28 @@ SeasonManager::EventResult SeasonManager::ProcessEvent(const RE::TESActivateEven
 	}
 
 	if (const auto tes = RE::TES::GetSingleton(); UpdateSeason()) {
-		tes->PurgeBufferedCells();
+		{
+			Trace::Span span("PurgeBufferedCells", "season");
+			tes->PurgeBufferedCells();
+		}
+		Trace::Write();
+	}
+
+	return EventResult::kContinue;
+}
+
+//swapped references go back to their original base when they detach, so original bases are only tracked for attached references
+//the event is sent while the cell is still tearing the reference down, so the base is only changed from a task once that is done,
+//and not at all if the reference was reattached (or its 3D reloaded) in the meantime, in which case it stays tracked
+SeasonManager::EventResult SeasonManager::ProcessEvent(const RE::TESCellAttachDetachEvent* a_event, RE::BSTEventSource<RE::TESCellAttachDetachEvent>*)
+{
+	//most detached references were never swapped, only queue a restore for the ones that were
+	if (a_event && !a_event->attached && a_event->reference && Cache::DataHolder::GetSingleton()->IsTracked(a_event->reference.get())) {
+		SKSE::GetTaskInterface()->AddTask([ref = a_event->reference]() {
+			if (const auto cell = ref->GetParentCell(); !ref->Is3DLoaded() && !(cell && cell->IsAttached())) {
+				Cache::DataHolder::GetSingleton()->RestoreOriginalBase(ref.get());
+			}
+		});
 	}
 
 	return EventResult::kContinue;
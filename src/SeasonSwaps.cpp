@@ -0,0 +1,82 @@
+#include "SeasonSwaps.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace SeasonSwaps
+{
+	namespace
+	{
+		// in-order walk of the implicit tree hands out the sorted keys, returns the next sorted index
+		std::size_t layout(std::span<const std::pair<std::uint32_t, Row>> a_sorted, std::uint32_t* a_keys, Row* a_rows, std::size_t a_index, std::size_t a_k)
+		{
+			if (a_k > a_sorted.size()) {
+				return a_index;
+			}
+
+			a_index = layout(a_sorted, a_keys, a_rows, a_index, 2 * a_k);
+			a_keys[a_k] = a_sorted[a_index].first;
+			a_rows[a_k] = a_sorted[a_index].second;
+			return layout(a_sorted, a_keys, a_rows, a_index + 1, 2 * a_k + 1);
+		}
+	}
+
+	void Table::Build(std::span<const Entry> a_entries)
+	{
+		std::array<std::vector<const Entry*>, typeCount> types;
+		for (const auto& entry : a_entries) {
+			if (entry.type < typeCount && entry.season < seasonCount) {
+				types[entry.type].push_back(&entry);
+			}
+		}
+
+		_index = {};
+		_keys.clear();
+		_rows.clear();
+
+		std::vector<std::pair<std::uint32_t, Row>> sorted;
+
+		for (std::size_t i = 0; i < typeCount; ++i) {
+			auto& entries = types[i];
+			if (entries.empty()) {
+				continue;
+			}
+
+			// stable, so the last entry of each season is applied last
+			std::ranges::stable_sort(entries, {}, &Entry::base);
+
+			sorted.clear();
+			for (const auto* entry : entries) {
+				if (sorted.empty() || sorted.back().first != entry->base) {
+					sorted.emplace_back(entry->base, Row{});
+				}
+				sorted.back().second[entry->season] = entry->swap;
+			}
+
+			const auto offset = _keys.size();
+			_index[i] = { static_cast<std::uint32_t>(offset), static_cast<std::uint32_t>(sorted.size()) };
+
+			_keys.resize(offset + sorted.size() + 1);
+			_rows.resize(offset + sorted.size() + 1);
+			layout(sorted, _keys.data() + offset, _rows.data() + offset, 0, 1);
+		}
+
+		_keys.shrink_to_fit();
+		_rows.shrink_to_fit();
+	}
+
+	std::size_t Table::size() const
+	{
+		std::size_t size = 0;
+		for (const auto& range : _index) {
+			size += range.size;
+		}
+		return size;
+	}
+
+	std::size_t Table::get_memory_usage(std::size_t a_type) const
+	{
+		const auto size = _index[a_type].size;
+		return size != 0 ? (size + 1) * (sizeof(std::uint32_t) + sizeof(Row)) : 0;
+	}
+}
@@ -110,17 +110,29 @@ FormSwapMap& Season::GetFormSwapMap()
 	return formMap;
 }
 
-void Season::LoadData(const CSimpleIniA& a_ini)
+std::optional<Season::ConfigData> Season::ParseConfig(const std::filesystem::path& a_path)
 {
-	formMap.LoadFormSwaps(a_ini);
+	const FormSwapParser::MappedFile file(a_path);
+	if (!file.is_open()) {
+		return std::nullopt;
+	}
 
-	CSimpleIniA::TNamesDepend values;
-	a_ini.GetAllKeys("Worldspaces", values);
-	values.sort(CSimpleIniA::Entry::LoadOrder());
+	FormSwapParser::Document document;
+	FormSwapParser::Parse(file.data(), FormSwapMap::recordTypeNames, document);
 
-	if (!values.empty()) {
-		std::ranges::transform(values, std::back_inserter(validWorldspaces), [&](const auto& val) { return val.pItem; });
-	}
+	ConfigData data;
+	data.swaps = FormSwapMap::ResolveFormSwaps(document);
+	data.worldspaces.assign(document.worldspaces.begin(), document.worldspaces.end());
+	data.malformed = document.malformed;
+
+	return data;
+}
+
+void Season::LoadData(const ConfigData& a_data)
+{
+	formMap.MergeFormSwaps(a_data.swaps);
+
+	validWorldspaces.insert(validWorldspaces.end(), a_data.worldspaces.begin(), a_data.worldspaces.end());
 }
 
 void Season::SaveData(CSimpleIniA& a_ini)
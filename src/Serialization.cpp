@@ -0,0 +1,58 @@
+#include "Serialization.h"
+#include "Papyrus.h"
+#include "SeasonManager.h"
+
+namespace Serialization
+{
+	std::string DecodeTypeCode(std::uint32_t a_typeCode)
+	{
+		constexpr std::size_t SIZE = sizeof(std::uint32_t);
+
+		std::string sig;
+		sig.resize(SIZE);
+		const char* iter = reinterpret_cast<char*>(&a_typeCode);
+		for (std::size_t i = 0, j = SIZE - 2; i < SIZE - 1; ++i, --j) {
+			sig[j] = iter[i];
+		}
+		return sig;
+	}
+
+	void SaveCallback(SKSE::SerializationInterface* a_intfc)
+	{
+		Papyrus::Events::Manager::GetSingleton()->Save(a_intfc, kSerializationVersion);
+		SeasonManager::GetSingleton()->Save(a_intfc, kSerializationVersion);
+
+		logger::info("Finished saving data"sv);
+	}
+
+	void LoadCallback(SKSE::SerializationInterface* a_intfc)
+	{
+		std::uint32_t type;
+		std::uint32_t version;
+		std::uint32_t length;
+		while (a_intfc->GetNextRecordInfo(type, version, length)) {
+			if (version != kSerializationVersion) {
+				logger::critical("Loaded data is out of date! Read ({}), expected ({}) for type code ({})", version, std::to_underlying(kSerializationVersion), DecodeTypeCode(type));
+				continue;
+			}
+			switch (type) {
+			case Papyrus::Events::Manager::kSeasonChange:
+				Papyrus::Events::Manager::GetSingleton()->Load(a_intfc, type);
+				break;
+			case SeasonManager::kSeasonState:
+				SeasonManager::GetSingleton()->Load(a_intfc);
+				break;
+			default:
+				logger::critical("Unrecognized record type ({})!", DecodeTypeCode(type));
+				break;
+			}
+		}
+
+		logger::info("Finished loading data"sv);
+	}
+
+	void RevertCallback(SKSE::SerializationInterface* a_intfc)
+	{
+		Papyrus::Events::Manager::GetSingleton()->Revert(a_intfc);
+	}
+}
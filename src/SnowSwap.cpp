@@ -1,19 +1,12 @@
 #include "SnowSwap.h"
+#include "Manifest.h"
 #include "SeasonManager.h"
 
 namespace SnowSwap
 {
 	void Manager::LoadSnowShaderSettings()
 	{
-		std::vector<std::string> configs;
-
-		for (constexpr auto folder = R"(Data\Seasons)"; const auto& entry : std::filesystem::directory_iterator(folder)) {
-			if (entry.is_regular_file() && entry.path().extension() == ".ini"sv) {
-				if (const auto path = entry.path().string(); path.contains("_SNOW") || path.contains("_NOSNOW")) {
-					configs.push_back(path);
-				}
-			}
-		}
+		const auto configs = Manifest::Manager::GetSingleton()->GetFiles(Manifest::FILE_TYPE::kSnowConfig);
 
 		if (configs.empty()) {
 			logger::info("No .ini files with _SNOW suffix were found in Data/Seasons folder. Snow Shader settings will not be loaded");
@@ -22,8 +15,10 @@ namespace SnowSwap
 
 		logger::info("{} matching inis found", configs.size());
 
-		for (auto& path : configs) {
-			logger::info("\tINI : {}", path);
+		for (const auto& config : configs) {
+			const auto& path = config->path;
+
+			logger::info("\tINI : {}", path.string());
 
 			CSimpleIniA ini;
 			ini.SetUnicode();
@@ -81,7 +76,7 @@ namespace SnowSwap
 		}
 
 		std::string model = a_form->As<RE::TESModel>()->GetModel();
-		return model.empty() || std::ranges::any_of(_snowShaderModelBlackList, [&](const auto& str) { return string::icontains(model, str); });
+		return model.empty() || std::ranges::any_of(_snowShaderModelBlackList, [&](const auto& str) { return StringSearch::icontains(model, str); });
 	}
 
 	bool Manager::GetWhitelistedForMultiPassSnow(const RE::TESForm* a_form) const
@@ -90,7 +85,7 @@ namespace SnowSwap
 
 		const auto it = std::ranges::find_if(_multipassSnowWhitelist, [&](const auto& a_type) {
 			if (std::holds_alternative<std::string>(a_type)) {
-				return string::icontains(model, std::get<std::string>(a_type));
+				return StringSearch::icontains(model, std::get<std::string>(a_type));
 			}
 			return a_form->GetFormID() == std::get<RE::FormID>(a_type);
 		});
@@ -308,4 +303,10 @@ namespace SnowSwap
 		}
 		return _singlePassSnowShader;
 	}
+
+	void Manager::GetMemoryStats(std::vector<MemoryStats::Table>& a_tables) const
+	{
+		Locker locker(_snowInfoLock);
+		a_tables.push_back(MemoryStats::GetTable("SnowSwap::SnowInfo", _snowInfoMap));
+	}
 }
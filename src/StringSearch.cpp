@@ -0,0 +1,162 @@
+#include "StringSearch.h"
+
+#if defined(_M_X64) || defined(__x86_64__)
+#	define STRING_SEARCH_X64
+#	include <immintrin.h>
+#	ifdef _MSC_VER
+#		include <intrin.h>
+#		define STRING_SEARCH_AVX2
+#	else
+#		define STRING_SEARCH_AVX2 __attribute__((target("avx2")))
+#	endif
+#endif
+
+namespace StringSearch
+{
+	namespace detail
+	{
+		constexpr char to_lower(char a_ch)
+		{
+			return a_ch >= 'A' && a_ch <= 'Z' ? static_cast<char>(a_ch + ('a' - 'A')) : a_ch;
+		}
+
+		inline bool iequals(const char* a_lhs, const char* a_rhs, std::size_t a_size)
+		{
+			for (std::size_t i = 0; i < a_size; ++i) {
+				if (to_lower(a_lhs[i]) != to_lower(a_rhs[i])) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		inline unsigned trailing_zeros(unsigned a_mask)
+		{
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, a_mask);
+			return index;
+#else
+			return static_cast<unsigned>(__builtin_ctz(a_mask));
+#endif
+		}
+
+#ifdef STRING_SEARCH_X64
+		// Compares the first and last needle characters against 16 candidate positions at once, ORing 0x20 to fold case.
+		// That also folds some punctuation together, so every hit is verified with a scalar compare.
+		bool icontains_sse2(std::string_view a_haystack, std::string_view a_needle)
+		{
+			const auto size = a_needle.size();
+			const auto last = a_haystack.size() - size;  // last candidate position
+
+			const auto fold = _mm_set1_epi8(0x20);
+			const auto firstChar = _mm_set1_epi8(static_cast<char>(a_needle.front() | 0x20));
+			const auto lastChar = _mm_set1_epi8(static_cast<char>(a_needle.back() | 0x20));
+
+			const auto data = a_haystack.data();
+
+			std::size_t i = 0;
+			for (; i + 16 <= last + 1; i += 16) {
+				const auto blockFirst = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)), fold);
+				const auto blockLast = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + size - 1)), fold);
+
+				auto mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, firstChar), _mm_cmpeq_epi8(blockLast, lastChar))));
+				while (mask != 0) {
+					if (iequals(data + i + trailing_zeros(mask), a_needle.data(), size)) {
+						return true;
+					}
+					mask &= mask - 1;
+				}
+			}
+
+			return icontains_scalar(a_haystack.substr(i), a_needle);
+		}
+
+		STRING_SEARCH_AVX2 bool icontains_avx2(std::string_view a_haystack, std::string_view a_needle)
+		{
+			const auto size = a_needle.size();
+			const auto last = a_haystack.size() - size;
+
+			const auto fold = _mm256_set1_epi8(0x20);
+			const auto firstChar = _mm256_set1_epi8(static_cast<char>(a_needle.front() | 0x20));
+			const auto lastChar = _mm256_set1_epi8(static_cast<char>(a_needle.back() | 0x20));
+
+			const auto data = a_haystack.data();
+
+			std::size_t i = 0;
+			for (; i + 32 <= last + 1; i += 32) {
+				const auto blockFirst = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)), fold);
+				const auto blockLast = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i + size - 1)), fold);
+
+				auto mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, firstChar), _mm256_cmpeq_epi8(blockLast, lastChar))));
+				while (mask != 0) {
+					if (iequals(data + i + trailing_zeros(mask), a_needle.data(), size)) {
+						return true;
+					}
+					mask &= mask - 1;
+				}
+			}
+
+			return icontains_sse2(a_haystack.substr(i), a_needle);
+		}
+
+		bool has_avx2()
+		{
+#	ifdef _MSC_VER
+			int info[4]{};
+			__cpuid(info, 0);
+			if (info[0] < 7) {
+				return false;
+			}
+			__cpuid(info, 1);
+			const bool osxsave = (info[2] & (1 << 27)) != 0;
+			const bool avx = (info[2] & (1 << 28)) != 0;
+			if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {  // OS saves YMM state
+				return false;
+			}
+			__cpuidex(info, 7, 0);
+			return (info[1] & (1 << 5)) != 0;
+#	else
+			return __builtin_cpu_supports("avx2");
+#	endif
+		}
+#endif
+
+		using Kernel = bool (*)(std::string_view, std::string_view);
+
+		Kernel select_kernel()
+		{
+#ifdef STRING_SEARCH_X64
+			return has_avx2() ? icontains_avx2 : icontains_sse2;
+#else
+			return icontains_scalar;
+#endif
+		}
+	}
+
+	bool icontains_scalar(std::string_view a_haystack, std::string_view a_needle)
+	{
+		if (a_needle.empty() || a_needle.size() > a_haystack.size()) {
+			return false;
+		}
+
+		const auto first = detail::to_lower(a_needle.front());
+		const auto last = a_haystack.size() - a_needle.size();
+		for (std::size_t i = 0; i <= last; ++i) {
+			if (detail::to_lower(a_haystack[i]) == first && detail::iequals(a_haystack.data() + i + 1, a_needle.data() + 1, a_needle.size() - 1)) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool icontains(std::string_view a_haystack, std::string_view a_needle)
+	{
+		static const auto kernel = detail::select_kernel();
+
+		if (a_needle.empty() || a_needle.size() > a_haystack.size()) {
+			return false;
+		}
+		return kernel(a_haystack, a_needle);
+	}
+}
@@ -0,0 +1,510 @@
+#include "SwapGenerator.h"
+
+#include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include "StringSearch.h"
+
+namespace SwapGenerator
+{
+	using namespace std::literals;
+
+	namespace detail
+	{
+		constexpr char to_lower(char a_ch)
+		{
+			return a_ch >= 'A' && a_ch <= 'Z' ? static_cast<char>(a_ch + ('a' - 'A')) : a_ch;
+		}
+
+		constexpr bool iequals(std::string_view a_lhs, std::string_view a_rhs)
+		{
+			return std::ranges::equal(a_lhs, a_rhs, [](char a_l, char a_r) { return to_lower(a_l) == to_lower(a_r); });
+		}
+
+		constexpr std::string_view trim(std::string_view a_str)
+		{
+			constexpr auto is_space = [](char a_ch) { return a_ch == ' ' || a_ch == '\t' || a_ch == '\r' || a_ch == '\n'; };
+			while (!a_str.empty() && is_space(a_str.front())) {
+				a_str.remove_prefix(1);
+			}
+			while (!a_str.empty() && is_space(a_str.back())) {
+				a_str.remove_suffix(1);
+			}
+			return a_str;
+		}
+
+		template <class String>
+		void replace_last_instance(String& a_str, std::string_view a_search)
+		{
+			if (const auto pos = a_str.rfind(a_search); pos != String::npos) {
+				a_str.erase(pos, a_search.size());
+			}
+		}
+
+		template <class String>
+		void replace_all(String& a_str, std::string_view a_search)
+		{
+			for (auto pos = a_str.find(a_search); pos != String::npos; pos = a_str.find(a_search, pos)) {
+				a_str.erase(pos, a_search.size());
+			}
+		}
+
+		//0xID~Plugin, uppercase hex without leading zeros
+		void append_form(std::string& a_str, const FormCatalog::Catalog& a_catalog, std::uint32_t a_row)
+		{
+			std::array<char, 8> buffer{};
+			const auto          end = std::to_chars(buffer.data(), buffer.data() + buffer.size(), a_catalog.localFormIDs[a_row], 16).ptr;
+
+			a_str.append("0x");
+			std::transform(buffer.data(), end, std::back_inserter(a_str), [](char a_ch) { return a_ch >= 'a' && a_ch <= 'f' ? static_cast<char>(a_ch - ('a' - 'A')) : a_ch; });
+			a_str.push_back('~');
+			a_str.append(a_catalog.get_file(a_row));
+		}
+
+		//model path from the last separator, "\\RockSnow01.nif"
+		std::string_view process_model_path(std::string_view a_path)
+		{
+			if (const auto it = a_path.rfind('\\'); it != std::string_view::npos) {
+				a_path.remove_prefix(it);
+			}
+			return a_path;
+		}
+
+		//snow model paths, matched against other models by substring
+		//paths that start at a separator can only match a model with the same basename, so those are looked up by basename hash
+		class SnowPaths
+		{
+		public:
+			using Match = std::pair<std::string_view, std::uint32_t>;
+
+			explicit SnowPaths(std::pmr::memory_resource* a_arena) :
+				_paths(a_arena),
+				_unrooted(a_arena),
+				_byBasename(a_arena)
+			{}
+
+			void emplace(std::string_view a_path, std::uint32_t a_row)
+			{
+				_paths.emplace_back(a_path, a_row);
+			}
+
+			//sort and dedup once all paths are in, first path wins
+			void build()
+			{
+				std::ranges::stable_sort(_paths, {}, &Match::first);
+				const auto [first, last] = std::ranges::unique(_paths, {}, &Match::first);
+				_paths.erase(first, last);
+
+				for (const auto& [path, row] : _paths) {
+					if (path.starts_with('\\')) {
+						_byBasename.emplace_back(FormCatalog::Catalog::hash_basename(path), Match{ path, row });
+					} else {
+						_unrooted.emplace_back(path, row);
+					}
+				}
+				std::ranges::sort(_byBasename, {}, &Rooted::first);
+			}
+
+			//snow rows whose path is in a_model, in path order
+			void find(std::string_view a_model, std::pmr::vector<Match>& a_matches) const
+			{
+				a_matches.clear();
+				if (const auto basename = process_model_path(a_model); basename.starts_with('\\')) {
+					const auto [first, last] = std::ranges::equal_range(_byBasename, FormCatalog::Catalog::hash_basename(basename), {}, &Rooted::first);
+					for (const auto& match : std::ranges::subrange(first, last) | std::views::values) {
+						if (match.first == basename) {
+							a_matches.push_back(match);
+						}
+					}
+				}
+				for (const auto& match : _unrooted) {
+					if (StringSearch::icontains(a_model, match.first)) {
+						a_matches.push_back(match);
+					}
+				}
+				std::ranges::sort(a_matches);
+			}
+
+		private:
+			using Rooted = std::pair<std::uint64_t, Match>;
+
+			std::pmr::vector<Match>  _paths;
+			std::pmr::vector<Match>  _unrooted;
+			std::pmr::vector<Rooted> _byBasename;
+		};
+
+		bool is_in_blacklist(std::string_view a_str, std::span<const std::string_view> a_blacklist)
+		{
+			return std::ranges::any_of(a_blacklist, [&](const auto& str) { return StringSearch::icontains(a_str, str); });
+		}
+
+		//activators, furniture, movable statics
+		void get_snow_variants_by_form(const FormCatalog::Catalog& a_catalog, const std::vector<std::uint32_t>& a_rows, Swaps& a_swaps, std::pmr::memory_resource* a_arena)
+		{
+			static constexpr std::array blackList = { "Blacksmith"sv, "Frozen"sv, "Marker"sv };
+
+			SnowPaths snowPaths(a_arena);
+			for (const auto row : a_rows) {
+				if (const auto model = a_catalog.get_model(row); !model.empty() && a_catalog.must_only_contain_textureset(row, FormCatalog::TXST::kSnow)) {
+					snowPaths.emplace(process_model_path(model), row);
+				}
+			}
+			snowPaths.build();
+
+			std::pmr::vector<SnowPaths::Match> matches(a_arena);
+			for (const auto row : a_rows) {
+				const auto model = a_catalog.get_model(row);
+				if (a_catalog.contains_textureset(row, FormCatalog::TXST::kSnow | FormCatalog::TXST::kFrozen) || is_in_blacklist(model, blackList)) {
+					continue;
+				}
+				snowPaths.find(model, matches);
+				if (!matches.empty()) {
+					a_swaps.emplace_back(row, matches.front().second);
+				}
+			}
+		}
+
+		void get_snow_variants_statics(const FormCatalog::Catalog& a_catalog, const std::vector<std::uint32_t>& a_rows, Swaps& a_swaps, std::pmr::memory_resource* a_arena)
+		{
+			static constexpr std::array snowBlackList = { "Ice"sv, "Icicle"sv, "Frozen"sv };
+			static constexpr std::array blackList = { "Ice"sv, "Icicle"sv, "Frozen"sv, "LoadScreen"sv, "INTERIOR"sv, "INV"sv, "DynDOLOD"sv };
+
+			constexpr auto snowMask = FormCatalog::TXST::kSnow | FormCatalog::TXST::kMask;
+
+			SnowPaths snowPaths(a_arena);
+			for (const auto row : a_rows) {
+				if (const auto model = a_catalog.get_model(row); !model.empty() && iequals(a_catalog.get_file(row), "SnowOverSkyrim.esp"sv)) {
+					snowPaths.emplace(process_model_path(model), row);
+				}
+			}
+			for (const auto row : a_rows) {
+				const bool snowMaterial = (a_catalog.rowFlags[row] & FormCatalog::ROW::kSnowMaterial) != 0;
+				if ((snowMaterial && a_catalog.only_contains_textureset(row, snowMask)) || a_catalog.must_only_contain_textureset(row, snowMask)) {
+					const auto model = a_catalog.get_model(row);
+					if (model.empty() || is_in_blacklist(a_catalog.get_editorID(row), snowBlackList)) {
+						continue;
+					}
+					snowPaths.emplace(process_model_path(model), row);
+				}
+			}
+			snowPaths.build();
+
+			std::pmr::string                   path(a_arena);
+			std::pmr::vector<SnowPaths::Match> matches(a_arena);
+			for (const auto row : a_rows) {
+				if ((a_catalog.rowFlags[row] & FormCatalog::ROW::kSnowMaterial) != 0 || is_in_blacklist(a_catalog.get_editorID(row), blackList)) {
+					continue;
+				}
+
+				path = a_catalog.get_model(row);
+				replace_last_instance(path, "moss"sv);
+
+				snowPaths.find(path, matches);
+				if (const auto it = std::ranges::find_if(matches, [&](const auto& a_match) { return a_match.second != row; }); it != matches.end()) {
+					a_swaps.emplace_back(row, it->second);
+				}
+			}
+		}
+
+		void get_snow_variants_trees(const FormCatalog::Catalog& a_catalog, const std::vector<std::uint32_t>& a_rows, Swaps& a_swaps, std::pmr::memory_resource* a_arena)
+		{
+			//snow tree models with "snow" removed, sorted by path, first tree wins
+			std::pmr::vector<std::pair<std::pmr::string, std::uint32_t>> processedSnowTrees(a_arena);
+			for (const auto row : a_rows) {
+				if (const auto model = a_catalog.get_model(row); model.find("snow"sv) != std::string_view::npos) {
+					auto& [path, snowRow] = processedSnowTrees.emplace_back(std::pmr::string(model, a_arena), row);
+					replace_all(path, "snow"sv);
+				}
+			}
+			std::ranges::stable_sort(processedSnowTrees, {}, [](const auto& a_tree) { return std::string_view(a_tree.first); });
+			const auto [first, last] = std::ranges::unique(processedSnowTrees, {}, [](const auto& a_tree) { return std::string_view(a_tree.first); });
+			processedSnowTrees.erase(first, last);
+
+			for (const auto row : a_rows) {
+				const auto model = a_catalog.get_model(row);
+				for (const auto& [path, snowRow] : processedSnowTrees) {
+					if (snowRow != row && StringSearch::icontains(model, path)) {
+						a_swaps.emplace_back(row, snowRow);
+						break;
+					}
+				}
+			}
+		}
+	}
+
+	std::optional<std::uint32_t> GenerateLandTextureSnowVariant(const FormCatalog::Catalog& a_catalog, std::uint32_t a_row)
+	{
+		using LAND_MATERIAL = FormCatalog::LAND_MATERIAL;
+
+		static constexpr std::array blackList = { "Snow"sv, "Ice"sv, "Winter"sv, "Frozen"sv, "Coast"sv, "River"sv };
+
+		const auto editorID = a_catalog.get_editorID(a_row);
+		if (!editorID.empty() && std::ranges::any_of(blackList, [&](const auto str) { return StringSearch::icontains(editorID, str); })) {
+			return std::nullopt;
+		}
+
+		static constexpr std::uint32_t LSnow01 = 0x0000089B;
+		static constexpr std::uint32_t LSnow02 = 0x0006A1B1;
+
+		const bool hasGrass = (a_catalog.rowFlags[a_row] & FormCatalog::ROW::kHasGrass) != 0;
+
+		std::uint32_t formID;
+
+		switch (static_cast<LAND_MATERIAL>(a_catalog.materials[a_row])) {
+		case LAND_MATERIAL::kGrass:
+			{
+				static constexpr std::uint32_t LGrassSnow01NoGrass = 0x0008B01E;
+				static constexpr std::uint32_t LGrassSnow01 = 0x00000894;
+
+				switch (a_catalog.formIDs[a_row]) {
+				case 0x0001342A:  // LFieldGrass02
+				case 0x00024E46:  // LFieldGrass01NoGrass
+				case 0x00024E30:  // LTundra01
+				case 0x000A2741:  // LTundra01NoGrass
+					formID = LSnow01;
+					break;
+				case 0x000134B7:  // LFieldDirtGrass01
+				case 0x000300E4:  // LTundra02
+					formID = LSnow02;
+					break;
+				default:
+					formID = hasGrass ? LGrassSnow01 : LGrassSnow01NoGrass;
+					break;
+				}
+			}
+			break;
+		case LAND_MATERIAL::kDirt:
+			{
+				static constexpr std::uint32_t LDirtSnowPath01 = 0x0001B082;
+
+				switch (a_catalog.formIDs[a_row]) {
+				case 0x00000C16:  // LDirt02
+					formID = LSnow02;
+					break;
+				case 0xB424C:  // LDirtPath01
+					formID = LDirtSnowPath01;
+					break;
+				default:
+					formID = LSnow01;
+					break;
+				}
+			}
+			break;
+		case LAND_MATERIAL::kStone:
+			{
+				static constexpr std::uint32_t LSnowRocks01 = 0x0006A1AF;
+				static constexpr std::uint32_t LSnowRockswGrass = 0x000F871F;
+
+				switch (a_catalog.formIDs[a_row]) {
+				case 0x0002C6C6:  // LTundraRocks01
+					formID = LSnowRocks01;
+					break;
+				case 0x0006DE8B:  // LTundraRocks01NoRocks
+					formID = LSnow01;
+					break;
+				default:
+					formID = hasGrass ? LSnowRockswGrass : LSnowRocks01;
+					break;
+				}
+			}
+			break;
+		case LAND_MATERIAL::kNoSnowVariant:
+			return std::nullopt;
+		default:
+			formID = LSnow02;
+			break;
+		}
+
+		const auto row = a_catalog.find(formID);
+		return row && a_catalog.types[*row] == FormCatalog::TYPE::kLandTexture ? row : std::nullopt;
+	}
+
+	void* CountingResource::do_allocate(std::size_t a_bytes, std::size_t a_alignment)
+	{
+		++_stats.allocations;
+		_stats.peakBytes = std::max(_stats.peakBytes, _bytes += a_bytes);
+		return _upstream->allocate(a_bytes, a_alignment);
+	}
+
+	void CountingResource::do_deallocate(void* a_ptr, std::size_t a_bytes, std::size_t a_alignment)
+	{
+		_bytes -= a_bytes;
+		_upstream->deallocate(a_ptr, a_bytes, a_alignment);
+	}
+
+	bool CountingResource::do_is_equal(const std::pmr::memory_resource& a_other) const noexcept
+	{
+		return this == &a_other;
+	}
+
+	Swaps GetSnowVariants(const FormCatalog::Catalog& a_catalog, FormCatalog::TYPE a_type, Stats* a_stats)
+	{
+		const auto rows = a_catalog.get_rows(a_type);
+
+		//scratch containers for this run, released all at once on return
+		std::pmr::monotonic_buffer_resource arena(rows.size() * 64);
+		CountingResource                    counter(&arena);
+
+		Swaps swaps;
+
+		switch (a_type) {
+		case FormCatalog::TYPE::kLandTexture:
+			for (const auto row : rows) {
+				if (const auto snowRow = GenerateLandTextureSnowVariant(a_catalog, row)) {
+					swaps.emplace_back(row, *snowRow);
+				}
+			}
+			break;
+		case FormCatalog::TYPE::kStatic:
+			detail::get_snow_variants_statics(a_catalog, rows, swaps, &counter);
+			break;
+		case FormCatalog::TYPE::kTree:
+			detail::get_snow_variants_trees(a_catalog, rows, swaps, &counter);
+			break;
+		default:
+			detail::get_snow_variants_by_form(a_catalog, rows, swaps, &counter);
+			break;
+		}
+
+		if (a_stats) {
+			*a_stats = counter.stats();
+		}
+
+		return swaps;
+	}
+
+	std::string GetComment(const FormCatalog::Catalog& a_catalog, std::uint32_t a_row, std::uint32_t a_snowRow)
+	{
+		std::string comment(";");
+		comment.append(a_catalog.get_editorID(a_row)).append("|").append(a_catalog.get_editorID(a_snowRow));
+		return comment;
+	}
+
+	std::string GetEntry(const FormCatalog::Catalog& a_catalog, std::uint32_t a_row, std::uint32_t a_snowRow)
+	{
+		std::string entry;
+		detail::append_form(entry, a_catalog, a_row);
+		entry.push_back('|');
+		detail::append_form(entry, a_catalog, a_snowRow);
+		return entry;
+	}
+
+	void SectionHash::append(std::string_view a_str)
+	{
+		for (const auto ch : a_str) {
+			_hash ^= static_cast<std::uint8_t>(ch);
+			_hash *= 0x100000001B3;
+		}
+		_hash ^= '\n';
+		_hash *= 0x100000001B3;
+	}
+
+	void SectionHash::add(std::string_view a_entry, std::string_view a_comment)
+	{
+		// ini readers may keep surrounding whitespace or line endings on either
+		append(detail::trim(a_comment));
+		append(detail::trim(a_entry));
+	}
+
+	std::uint64_t HashSection(const FormCatalog::Catalog& a_catalog, const Swaps& a_swaps)
+	{
+		SectionHash hash;
+		for (const auto& [row, snowRow] : a_swaps) {
+			hash.add(GetEntry(a_catalog, row, snowRow), GetComment(a_catalog, row, snowRow));
+		}
+		return hash.value();
+	}
+
+	void WriteSection(std::ostream& a_stream, const FormCatalog::Catalog& a_catalog, FormCatalog::TYPE a_type, const Swaps& a_swaps)
+	{
+		a_stream << '[' << sectionNames[static_cast<std::size_t>(a_type)] << "]\n";
+		for (const auto& [row, snowRow] : a_swaps) {
+			a_stream << GetComment(a_catalog, row, snowRow) << '\n'
+					 << GetEntry(a_catalog, row, snowRow) << '\n';
+		}
+		a_stream << '\n';
+	}
+
+	std::vector<Section> SplitSections(std::string_view a_data)
+	{
+		if (a_data.starts_with(std::string_view{ "\xEF\xBB\xBF" })) {
+			a_data.remove_prefix(3);
+		}
+
+		std::vector<Section> sections(1);
+		sections.back().text = a_data.substr(0, 0);
+
+		SectionHash      hash;
+		std::string_view comment;
+
+		const auto close_section = [&](std::size_t a_end) {
+			auto& section = sections.back();
+			section.text = std::string_view(section.text.data(), a_data.data() + a_end);
+			section.hash = hash.value();
+		};
+
+		for (std::size_t pos = 0; pos < a_data.size();) {
+			const auto eol = a_data.find('\n', pos);
+			const auto next = eol == std::string_view::npos ? a_data.size() : eol + 1;
+			const auto line = detail::trim(a_data.substr(pos, next - pos));
+
+			if (line.starts_with('[')) {
+				close_section(pos);
+
+				auto& section = sections.emplace_back();
+				section.name = detail::trim(line.substr(1, line.find(']') - 1));
+				section.text = a_data.substr(pos, 0);
+
+				hash = {};
+				comment = {};
+			} else if (line.starts_with(';') || line.starts_with('#')) {
+				comment = line;
+			} else if (!line.empty()) {
+				hash.add(line.substr(0, line.find('=')), comment);
+				++sections.back().entries;
+				comment = {};
+			}
+
+			pos = next;
+		}
+		close_section(a_data.size());
+
+		return sections;
+	}
+
+	void WriteFile(std::ostream& a_stream, const FormCatalog::Catalog& a_catalog, std::span<const Section> a_existing, const Regenerated& a_regenerated)
+	{
+		a_stream << "\xEF\xBB\xBF";
+
+		std::array<bool, std::tuple_size_v<Regenerated>> written{};
+
+		const auto find_type = [](std::string_view a_name) {
+			return static_cast<std::size_t>(std::ranges::find_if(sectionNames, [&](const auto& a_section) { return detail::iequals(a_name, a_section); }) - sectionNames.begin());
+		};
+
+		for (const auto& section : a_existing) {
+			if (const auto i = find_type(section.name); !section.name.empty() && i < a_regenerated.size() && a_regenerated[i]) {
+				//duplicate headers collapse into one section, like the ini loader does
+				if (!std::exchange(written[i], true)) {
+					WriteSection(a_stream, a_catalog, static_cast<FormCatalog::TYPE>(i), *a_regenerated[i]);
+				}
+			} else if (!section.text.empty()) {
+				a_stream << section.text;
+				if (!section.text.ends_with('\n')) {
+					a_stream << '\n';
+				}
+			}
+		}
+
+		for (std::size_t i = 0; i < a_regenerated.size(); ++i) {
+			if (a_regenerated[i] && !written[i]) {
+				WriteSection(a_stream, a_catalog, static_cast<FormCatalog::TYPE>(i), *a_regenerated[i]);
+			}
+		}
+	}
+}
@@ -0,0 +1,176 @@
+#include "Trace.h"
+
+namespace Trace
+{
+	namespace detail
+	{
+		struct Event
+		{
+			std::string_view name;
+			std::string_view category;
+			std::string      detail;
+			std::int64_t     start;     // us since the first span
+			std::int64_t     duration;  // us
+			std::uint32_t    thread;
+		};
+
+		class Buffer
+		{
+		public:
+			static Buffer& GetSingleton()
+			{
+				static Buffer singleton;
+				return singleton;
+			}
+
+			void Push(Event&& a_event)
+			{
+				std::scoped_lock locker(_lock);
+				if (_events.size() < capacity) {
+					_events.push_back(std::move(a_event));
+				} else {
+					_events[_next] = std::move(a_event);
+				}
+				_next = (_next + 1) % capacity;
+			}
+
+			void Clear()
+			{
+				std::scoped_lock locker(_lock);
+				_events.clear();
+				_next = 0;
+			}
+
+			//oldest first
+			std::vector<Event> GetEvents()
+			{
+				std::scoped_lock   locker(_lock);
+				std::vector<Event> events;
+				events.reserve(_events.size());
+				if (_events.size() == capacity) {
+					events.insert(events.end(), _events.begin() + _next, _events.end());
+					events.insert(events.end(), _events.begin(), _events.begin() + _next);
+				} else {
+					events = _events;
+				}
+				return events;
+			}
+
+		private:
+			static constexpr std::size_t capacity = 4096;
+
+			std::mutex         _lock;
+			std::vector<Event> _events;
+			std::size_t        _next{ 0 };
+		};
+
+		std::atomic_bool enabled{ true };
+		const auto       epoch = std::chrono::steady_clock::now();
+
+		std::uint32_t get_thread_id()
+		{
+			static std::atomic_uint32_t nextID{ 1 };
+			thread_local const auto     id = nextID.fetch_add(1, std::memory_order_relaxed);
+			return id;
+		}
+
+		std::int64_t to_us(std::chrono::steady_clock::time_point a_time)
+		{
+			return std::chrono::duration_cast<std::chrono::microseconds>(a_time - epoch).count();
+		}
+
+		void append_escaped(std::string& a_out, std::string_view a_str)
+		{
+			for (const auto ch : a_str) {
+				switch (ch) {
+				case '"':
+					a_out += "\\\"";
+					break;
+				case '\\':
+					a_out += "\\\\";
+					break;
+				case '\n':
+					a_out += "\\n";
+					break;
+				default:
+					if (static_cast<unsigned char>(ch) < 0x20) {
+						a_out += std::format("\\u{:04x}", static_cast<int>(ch));
+					} else {
+						a_out += ch;
+					}
+					break;
+				}
+			}
+		}
+	}
+
+	void SetEnabled(bool a_enabled)
+	{
+		detail::enabled = a_enabled;
+		if (!a_enabled) {
+			detail::Buffer::GetSingleton().Clear();
+		}
+	}
+
+	bool IsEnabled()
+	{
+		return detail::enabled;
+	}
+
+	Span::Span(std::string_view a_name, std::string_view a_category) :
+		_name(a_name),
+		_category(a_category),
+		_start(std::chrono::steady_clock::now()),
+		_enabled(IsEnabled())
+	{}
+
+	Span::~Span()
+	{
+		if (!_enabled || !IsEnabled()) {
+			return;
+		}
+
+		const auto start = detail::to_us(_start);
+		detail::Buffer::GetSingleton().Push({ _name, _category, std::move(_detail), start, detail::to_us(std::chrono::steady_clock::now()) - start, detail::get_thread_id() });
+	}
+
+	void Write()
+	{
+		if (!IsEnabled()) {
+			return;
+		}
+
+		auto path = logger::log_directory();
+		if (!path) {
+			return;
+		}
+		*path /= std::format("{}.trace.json", Version::PROJECT);
+
+		std::string json{ "{\"traceEvents\":[\n" };
+		for (bool first = true; const auto& [name, category, args, start, duration, thread] : detail::Buffer::GetSingleton().GetEvents()) {
+			if (!std::exchange(first, false)) {
+				json += ",\n";
+			}
+			json += "{\"name\":\"";
+			detail::append_escaped(json, name);
+			json += "\",\"cat\":\"";
+			detail::append_escaped(json, category);
+			json += std::format("\",\"ph\":\"X\",\"ts\":{},\"dur\":{},\"pid\":1,\"tid\":{}", start, duration, thread);
+			if (!args.empty()) {
+				json += ",\"args\":{\"detail\":\"";
+				detail::append_escaped(json, args);
+				json += "\"}";
+			}
+			json += "}";
+		}
+		json += "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+		//spans can finish on worker threads while another write is in progress
+		static std::mutex writeLock;
+		std::scoped_lock  locker(writeLock);
+
+		if (std::ofstream file(*path, std::ios::binary | std::ios::trunc); !file || !file.write(json.data(), static_cast<std::streamsize>(json.size()))) {
+			logger::error("Couldn't write {}", path->string());
+		}
+	}
+}
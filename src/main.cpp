@@ -2,9 +2,13 @@
 #include "FormSwap.h"
 #include "LODSwap.h"
 #include "LandscapeSwap.h"
+#include "Manifest.h"
 #include "Papyrus.h"
+#include "Persistence.h"
 #include "SeasonManager.h"
+#include "Serialization.h"
 #include "SnowSwap.h"
+#include "Trace.h"
 
 REL::Version gameVersion{};
 
@@ -13,7 +17,10 @@ void MessageHandler(SKSE::MessagingInterface::Message* a_message)
 	switch (a_message->type) {
 	case SKSE::MessagingInterface::kPostLoad:
 		{
+			Trace::Span span("kPostLoad");
+
 			try {
+				Trace::Span settingsSpan("LoadSettings");
 				SeasonManager::GetSingleton()->LoadSettings();
 			} catch (...) {
 				logger::error("Exception caught when loading settings! Check whether your setting values are valid. Default values will be used instead");
@@ -21,6 +28,8 @@ void MessageHandler(SKSE::MessagingInterface::Message* a_message)
 
 			logger::info("{:*^30}", "HOOKS");
 
+			Trace::Span hooksSpan("InstallHooks");
+
 			SeasonManager::InstallHooks();
 
 			FormSwap::Install();
@@ -44,6 +53,8 @@ void MessageHandler(SKSE::MessagingInterface::Message* a_message)
 		break;
 	case SKSE::MessagingInterface::kDataLoaded:
 		{
+			std::optional<Trace::Span> span(std::in_place, "kDataLoaded");
+
 			logger::info("{:*^30}", "DEPENDENCIES");
 
 			auto tweaks = GetModuleHandle(L"po3_Tweaks");
@@ -65,7 +76,10 @@ void MessageHandler(SKSE::MessagingInterface::Message* a_message)
 				RE::ConsoleLog::GetSingleton()->Print(error.c_str());
 			}
 
-			Cache::DataHolder::GetSingleton()->GetData();
+			{
+				Trace::Span dataSpan("Cache::GetData");
+				Cache::DataHolder::GetSingleton()->GetData();
+			}
 
 			logger::info("{:*^30}", "CONFIG");
 
@@ -75,23 +89,51 @@ void MessageHandler(SKSE::MessagingInterface::Message* a_message)
 				std::filesystem::create_directory(seasonsPath);
 			}
 
-			SnowSwap::Manager::GetSingleton()->LoadSnowShaderSettings();
+			{
+				Trace::Span manifestSpan("Manifest::Scan");
+				Manifest::Manager::GetSingleton()->Scan();
+			}
+			{
+				Trace::Span shaderSpan("LoadSnowShaderSettings");
+				SnowSwap::Manager::GetSingleton()->LoadSnowShaderSettings();
+			}
 
 			const auto manager = SeasonManager::GetSingleton();
-			manager->LoadOrGenerateWinterFormSwap();
-			manager->LoadSeasonData();
-
-			manager->CheckLODExists();
-			LODSwap::Install();
+			{
+				Trace::Span formSwapSpan("LoadOrGenerateWinterFormSwap");
+				manager->LoadOrGenerateWinterFormSwap();
+			}
+			{
+				Trace::Span seasonSpan("LoadSeasonData");
+				manager->LoadSeasonData();
+			}
+			{
+				Trace::Span lodSpan("CheckLODExists");
+				manager->CheckLODExists();
+				LODSwap::Install();
+			}
 
 			manager->RegisterEvents();
-			manager->CleanupSerializedSeasonList();
+			{
+				Trace::Span cleanupSpan("CleanupSerializedSeasonList");
+				manager->CleanupSerializedSeasonList();
+			}
+
+			MemoryStats::Log("Data loaded");
+
+			Persistence::Manager::GetSingleton()->Flush();
+
+			span.reset();
+			Trace::Write();
 		}
 		break;
 	case SKSE::MessagingInterface::kSaveGame:
 		{
 			std::string_view savePath{ static_cast<char*>(a_message->data), a_message->dataLen };
 			SeasonManager::GetSingleton()->SaveSeason(savePath);
+
+			CallTrace::Recorder::GetSingleton().Flush();
+			Persistence::Manager::GetSingleton()->Flush();
 		}
 		break;
 	case SKSE::MessagingInterface::kPreLoadGame:
@@ -99,13 +141,18 @@ void MessageHandler(SKSE::MessagingInterface::Message* a_message)
 			std::string savePath{ static_cast<char*>(a_message->data), a_message->dataLen };
 			string::replace_last_instance(savePath, ".ess", "");
 
+			//no wait for the main WIN formswap here, the SetInterior hook waits once an exterior cell loads
 			SeasonManager::GetSingleton()->LoadSeason(savePath);
+
+			Persistence::Manager::GetSingleton()->Flush();
 		}
 		break;
 	case SKSE::MessagingInterface::kDeleteGame:
 		{
 			std::string_view savePath{ static_cast<char*>(a_message->data), a_message->dataLen };
 			SeasonManager::GetSingleton()->ClearSeason(savePath);
+
+			Persistence::Manager::GetSingleton()->Flush();
 		}
 		break;
 	default:
@@ -191,6 +238,12 @@ extern "C" DLLEXPORT bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* a_s
 	const auto papyrus = SKSE::GetPapyrusInterface();
 	papyrus->Register(Papyrus::Bind);
 
+	const auto serialization = SKSE::GetSerializationInterface();
+	serialization->SetUniqueID(Serialization::kSeasons);
+	serialization->SetSaveCallback(Serialization::SaveCallback);
+	serialization->SetLoadCallback(Serialization::LoadCallback);
+	serialization->SetRevertCallback(Serialization::RevertCallback);
+
 	return true;
 }
 
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <string_view>
+
+// clib_util::string::icontains (CLibUtil 1.4.4), what the plugin used before StringSearch
+// Kept verbatim as the reference StringSearch::icontains is checked and benchmarked against.
+namespace ClibString
+{
+	inline bool icontains(std::string_view a_str1, std::string_view a_str2)
+	{
+		if (a_str2.length() > a_str1.length()) {
+			return false;
+		}
+
+		const auto subrange = std::ranges::search(a_str1, a_str2, [](unsigned char ch1, unsigned char ch2) {
+			return std::toupper(ch1) == std::toupper(ch2);
+		});
+
+		return !subrange.empty();
+	}
+}
@@ -0,0 +1,233 @@
+#include "SyntheticCatalog.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ankerl/unordered_dense.h>
+
+namespace SyntheticCatalog
+{
+	using namespace std::literals;
+
+	namespace detail
+	{
+		using TYPE = FormCatalog::TYPE;
+
+		struct TypeInfo
+		{
+			double                            share;  // of generated forms
+			std::span<const std::string_view> folders;
+			std::span<const std::string_view> names;
+			double                            snowShare;  // of model families with a snow variant
+		};
+
+		constexpr std::array landFolders{ R"(landscape\)"sv };
+		constexpr std::array landNames{ "grass"sv, "dirt"sv, "rocks"sv, "mud"sv, "tundra"sv, "fieldgrass"sv, "gravel"sv };
+
+		constexpr std::array activatorFolders{ R"(dungeons\nordic\)"sv, R"(clutter\)"sv, R"(architecture\farmhouse\)"sv };
+		constexpr std::array activatorNames{ "lever"sv, "puzzlepillar"sv, "shrine"sv, "doorway"sv, "pullchain"sv, "well"sv };
+
+		constexpr std::array furnitureFolders{ R"(furniture\)"sv, R"(furniture\noble\)"sv };
+		constexpr std::array furnitureNames{ "bed"sv, "chair"sv, "bench"sv, "workbench"sv, "tanningrack"sv, "grindstone"sv };
+
+		constexpr std::array movableFolders{ R"(effects\)"sv, R"(landscape\waterfalls\)"sv, R"(clutter\banners\)"sv };
+		constexpr std::array movableNames{ "waterfall"sv, "fxsmokecolumn"sv, "banner"sv, "fxmist"sv, "riverrapids"sv };
+
+		constexpr std::array staticFolders{ R"(landscape\rocks\)"sv, R"(landscape\mountains\)"sv, R"(architecture\whiterun\)"sv, R"(architecture\windhelm\)"sv, R"(dungeons\caves\)"sv, R"(clutter\)"sv };
+		constexpr std::array staticNames{ "rockcliff"sv, "rockpile"sv, "mountaincliff"sv, "wrwall"sv, "whwall"sv, "cavewall"sv, "fence"sv, "boulder"sv };
+
+		constexpr std::array treeFolders{ R"(landscape\trees\)"sv, R"(landscape\plants\)"sv };
+		constexpr std::array treeNames{ "treepineforest"sv, "treeaspen"sv, "shrubforest"sv, "treeoak"sv, "treepinefrost"sv };
+
+		// roughly the generated record types in the vanilla masters
+		constexpr std::array<TypeInfo, static_cast<std::size_t>(TYPE::kTotal)> typeInfos{ {
+			{ 0.015, landFolders, landNames, 0.0 },
+			{ 0.18, activatorFolders, activatorNames, 0.05 },
+			{ 0.06, furnitureFolders, furnitureNames, 0.05 },
+			{ 0.10, movableFolders, movableNames, 0.05 },
+			{ 0.62, staticFolders, staticNames, 0.10 },
+			{ 0.025, treeFolders, treeNames, 0.15 },
+		} };
+
+		constexpr std::array editorIDBlackList{ "Marker"sv, "DynDOLOD"sv, "INTERIOR"sv, "Frozen"sv };
+
+		// vanilla land textures GenerateLandTextureSnowVariant swaps to
+		constexpr std::array snowLandTextures{ 0x0000089Bu, 0x0006A1B1u, 0x0008B01Eu, 0x00000894u, 0x0001B082u, 0x0006A1AFu, 0x000F871Fu };
+
+		struct Plugin
+		{
+			std::string   name;
+			std::uint32_t prefix;
+			std::uint32_t nextLocalID{ 0x800 };
+		};
+
+		class Builder
+		{
+		public:
+			explicit Builder(std::uint32_t a_seed) :
+				_rng(a_seed)
+			{
+				for (const auto master : { "Skyrim.esm"sv, "Update.esm"sv, "Dawnguard.esm"sv, "HearthFires.esm"sv, "Dragonborn.esm"sv, "SnowOverSkyrim.esp"sv }) {
+					add_plugin(std::string(master));
+				}
+				// keep clear of the hardcoded vanilla land textures
+				_plugins[skyrim].nextLocalID = 0x00100000;
+
+				for (const auto formID : snowLandTextures) {
+					_catalog.add({ .formID = formID, .localFormID = formID, .type = TYPE::kLandTexture, .file = "Skyrim.esm"sv, .editorID = "LSnow"sv, .material = static_cast<std::uint32_t>(FormCatalog::LAND_MATERIAL::kNoSnowVariant) });
+				}
+			}
+
+			FormCatalog::Catalog Build(std::size_t a_forms)
+			{
+				_forms = a_forms;
+
+				std::vector<double> shares;
+				for (const auto& info : typeInfos) {
+					shares.push_back(info.share);
+				}
+				std::discrete_distribution<std::size_t> typeDist(shares.begin(), shares.end());
+
+				while (_catalog.size() < a_forms) {
+					const auto type = static_cast<TYPE>(typeDist(_rng));
+					add_form(type, get_plugin(_catalog.size()));
+				}
+
+				return std::move(_catalog);
+			}
+
+		private:
+			static constexpr std::size_t skyrim = 0;
+			static constexpr std::size_t snowOverSkyrim = 5;
+
+			// forms per plugin past the masters
+			static constexpr std::size_t vanillaForms = 32'000;
+			static constexpr std::size_t modForms = 5'000;
+
+			void add_plugin(std::string a_name)
+			{
+				_plugins.push_back({ std::move(a_name), static_cast<std::uint32_t>(_plugins.size()) << 24 });
+			}
+
+			std::size_t get_plugin(std::size_t a_form)
+			{
+				if (a_form < vanillaForms) {
+					return a_form < 25'000 ? skyrim : 1 + (a_form - 25'000) * 4 / (vanillaForms - 25'000);
+				}
+
+				const auto index = snowOverSkyrim + 1 + (a_form - vanillaForms) / modForms;
+				while (_plugins.size() <= index) {
+					add_plugin("Mod" + std::to_string(_plugins.size()) + ".esp");
+				}
+				return index;
+			}
+
+			std::uint32_t next_formID(std::size_t a_plugin, std::uint32_t& a_localID)
+			{
+				auto& plugin = _plugins[a_plugin];
+				a_localID = plugin.nextLocalID++;
+				return plugin.prefix | a_localID;
+			}
+
+			std::string_view pick(std::span<const std::string_view> a_values)
+			{
+				return a_values[std::uniform_int_distribution<std::size_t>(0, a_values.size() - 1)(_rng)];
+			}
+
+			bool chance(double a_probability)
+			{
+				return std::uniform_real_distribution<double>(0.0, 1.0)(_rng) < a_probability;
+			}
+
+			// several forms share each model, like reused meshes with different texture swaps
+			std::size_t get_family(TYPE a_type)
+			{
+				const auto expected = static_cast<double>(_forms) * typeInfos[static_cast<std::size_t>(a_type)].share;
+				return std::uniform_int_distribution<std::size_t>(0, std::max<std::size_t>(8, static_cast<std::size_t>(expected / 6)))(_rng);
+			}
+
+			void add_form(TYPE a_type, std::size_t a_plugin)
+			{
+				const auto& info = typeInfos[static_cast<std::size_t>(a_type)];
+
+				const auto  family = get_family(a_type);
+				const auto  folder = pick(info.folders);
+				const auto  name = pick(info.names);
+				const auto  familyName = std::string(name) + std::to_string(family);
+				const auto  model = std::string(folder) + familyName + ".nif";
+
+				auto editorID = familyName + "_" + std::to_string(_catalog.size());
+				if (chance(0.01)) {
+					editorID += pick(editorIDBlackList);
+				}
+
+				_altTextures.assign(std::uniform_int_distribution<std::size_t>(0, 3)(_rng), FormCatalog::TXST::kNone);
+
+				std::uint32_t localID{};
+				if (a_type == TYPE::kLandTexture) {
+					_catalog.add({ .formID = next_formID(a_plugin, localID),
+						.localFormID = localID,
+						.type = a_type,
+						.file = _plugins[a_plugin].name,
+						.editorID = editorID,
+						.material = std::uniform_int_distribution<std::uint32_t>(0, 4)(_rng),
+						.flags = static_cast<std::uint8_t>(chance(0.5) ? FormCatalog::ROW::kHasGrass : FormCatalog::ROW::kNone) });
+					return;
+				}
+
+				_catalog.add({ .formID = next_formID(a_plugin, localID), .localFormID = localID, .type = a_type, .file = _plugins[a_plugin].name, .model = model, .editorID = editorID, .altTextures = _altTextures });
+
+				// at most one snow variant per model
+				if (chance(info.snowShare) && _snowModels.emplace(model).second) {
+					add_snow_variant(a_type, folder, familyName, model, editorID);
+				}
+			}
+
+			void add_snow_variant(TYPE a_type, std::string_view a_folder, const std::string& a_familyName, const std::string& a_model, const std::string& a_editorID)
+			{
+				std::uint32_t localID{};
+				const auto    formID = next_formID(snowOverSkyrim, localID);
+				const auto    editorID = a_editorID + "Snow";
+
+				switch (a_type) {
+				case TYPE::kStatic:
+					if (chance(0.5)) {
+						// SnowOverSkyrim.esp static with the same basename
+						_catalog.add({ .formID = formID, .localFormID = localID, .type = a_type, .file = _plugins[snowOverSkyrim].name, .model = R"(sos\)" + a_model, .editorID = editorID });
+					} else {
+						// snow material and snow/mask texture sets
+						_altTextures.assign(2, FormCatalog::TXST::kSnow | FormCatalog::TXST::kMask);
+						_catalog.add({ .formID = formID, .localFormID = localID, .type = a_type, .file = _plugins[snowOverSkyrim].name, .model = a_model, .editorID = editorID, .flags = FormCatalog::ROW::kSnowMaterial, .altTextures = _altTextures });
+					}
+					break;
+				case TYPE::kTree:
+					// "snow" in the model path, removed when matching
+					_catalog.add({ .formID = formID, .localFormID = localID, .type = a_type, .file = _plugins[snowOverSkyrim].name, .model = std::string(a_folder) + a_familyName + "snow.nif", .editorID = editorID });
+					break;
+				default:
+					// same model, only snow texture sets
+					_altTextures.assign(2, FormCatalog::TXST::kSnow);
+					_catalog.add({ .formID = formID, .localFormID = localID, .type = a_type, .file = _plugins[snowOverSkyrim].name, .model = a_model, .editorID = editorID, .altTextures = _altTextures });
+					break;
+				}
+			}
+
+			std::mt19937                              _rng;
+			std::size_t                               _forms{ 0 };
+			FormCatalog::Catalog                      _catalog;
+			std::vector<Plugin>                       _plugins;
+			std::vector<std::uint8_t>                 _altTextures;
+			ankerl::unordered_dense::set<std::string> _snowModels;
+		};
+	}
+
+	FormCatalog::Catalog Generate(std::size_t a_forms, std::uint32_t a_seed)
+	{
+		return detail::Builder(a_seed).Build(a_forms);
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "FormCatalog.h"
+
+// Deterministic form catalogs shaped like a modded load order, for benchmarking swap generation at scale
+// Record type mix follows the vanilla masters; many forms share a model, and a fraction of models have snow variants
+// laid out the way SnowOverSkyrim.esp, snow texture sets and "snow" tree models are matched.
+namespace SyntheticCatalog
+{
+	// a_forms is spread over the vanilla masters, SnowOverSkyrim.esp and as many 5000 form mods as needed (up to ~1.2M forms)
+	FormCatalog::Catalog Generate(std::size_t a_forms, std::uint32_t a_seed = 0x5EA5);
+}
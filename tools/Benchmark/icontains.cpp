@@ -0,0 +1,160 @@
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ClibString.h"
+#include "StringSearch.h"
+
+using namespace std::literals;
+
+namespace
+{
+	std::mt19937 rng{ 0x5EA5 };
+
+	// characters that ORing 0x20 folds onto each other without being letters, and a few that only differ in case
+	constexpr auto trickyChars = "aAzZsS@`[{\\|]}^~_\x7f\xc0\xe0/.09 "sv;
+
+	std::size_t cases = 0;
+	std::size_t mismatches = 0;
+
+	std::string escape(std::string_view a_str)
+	{
+		std::string result;
+		for (const auto ch : a_str) {
+			if (const auto byte = static_cast<unsigned char>(ch); byte < 0x20 || byte >= 0x7f) {
+				char hex[5];
+				std::snprintf(hex, sizeof(hex), "\\x%02X", byte);
+				result += hex;
+			} else {
+				result += ch;
+			}
+		}
+		return result;
+	}
+
+	void check(std::string_view a_haystack, std::string_view a_needle)
+	{
+		++cases;
+
+		const auto expected = ClibString::icontains(a_haystack, a_needle);
+		const auto simd = StringSearch::icontains(a_haystack, a_needle);
+		const auto scalar = StringSearch::icontains_scalar(a_haystack, a_needle);
+		if (simd != expected || scalar != expected) {
+			if (++mismatches <= 20) {
+				std::printf("mismatch\t\"%s\"\t\"%s\"\texpected %d, icontains %d, icontains_scalar %d\n", escape(a_haystack).c_str(), escape(a_needle).c_str(), expected, simd, scalar);
+			}
+		}
+	}
+
+	char random_char(std::string_view a_chars)
+	{
+		return a_chars[std::uniform_int_distribution<std::size_t>(0, a_chars.size() - 1)(rng)];
+	}
+
+	char flip_case(char a_ch)
+	{
+		return (a_ch >= 'a' && a_ch <= 'z') || (a_ch >= 'A' && a_ch <= 'Z') ? static_cast<char>(a_ch ^ 0x20) : a_ch;
+	}
+
+	// a different character that still passes the 0x20 fold filter, letters get a neighbouring letter
+	char near_miss(char a_ch)
+	{
+		if ((a_ch >= 'a' && a_ch <= 'z') || (a_ch >= 'A' && a_ch <= 'Z')) {
+			return a_ch == 'z' || a_ch == 'Z' ? static_cast<char>(a_ch - 1) : static_cast<char>(a_ch + 1);
+		}
+		return static_cast<char>(a_ch ^ 0x20);
+	}
+
+	// every haystack length around the 16 and 32 byte blocks, every needle length and every needle position
+	void check_lengths()
+	{
+		std::string haystack;
+		std::string needle;
+		for (std::size_t size = 0; size <= 100; ++size) {
+			for (std::size_t needleSize = 0; needleSize <= size + 1; ++needleSize) {
+				haystack.clear();
+				for (std::size_t i = 0; i < size; ++i) {
+					haystack += random_char(trickyChars);
+				}
+
+				for (std::size_t pos = 0; pos + needleSize <= size; ++pos) {
+					needle = haystack.substr(pos, needleSize);
+					for (auto& ch : needle) {
+						if (rng() & 1) {
+							ch = flip_case(ch);
+						}
+					}
+					check(haystack, needle);
+
+					// near misses at the ends, which the SIMD filter compares after folding, and in the middle, which only the verify compares
+					if (!needle.empty()) {
+						auto miss = needle;
+						miss.back() = near_miss(miss.back());
+						check(haystack, miss);
+
+						miss = needle;
+						miss.front() = near_miss(miss.front());
+						check(haystack, miss);
+
+						if (needle.size() > 2) {
+							miss = needle;
+							miss[needle.size() / 2] = near_miss(miss[needle.size() / 2]);
+							check(haystack, miss);
+						}
+					}
+				}
+
+				// longer than the haystack, and not in it at all
+				needle.assign(needleSize, '#');
+				check(haystack, needle);
+			}
+		}
+	}
+
+	// model paths and editorIDs against the blacklists and keywords the plugin searches for
+	void check_paths()
+	{
+		static constexpr std::array folders{ R"(Landscape\Rocks\)"sv, R"(architecture\whiterun\)"sv, R"(Clutter\)"sv, R"(landscape\trees\)"sv, R"(Dungeons\Nordic\)"sv, R"(Effects\)"sv, R"(lod\)"sv, R"(DynDOLOD\lod\Sky\)"sv, ""sv };
+		static constexpr std::array names{ "RockCliff"sv, "WRWoodPlankFloor"sv, "Bucket"sv, "TreePineForest"sv, "NorCaveWall"sv, "SnowDrift"sv, "Icicle"sv, "WetRocks"sv, "FXBrazier"sv, "XMarker"sv, "MountainSlab"sv };
+		static constexpr std::array needles{ R"(Effects\)"sv, R"(Sky\)"sv, R"(lod\)"sv, "WetRocks"sv, "DynDOLOD"sv, "Marker"sv, "Brazier"sv, "Snow"sv, "Ice"sv, "Frozen"sv, "Mountain"sv, "Rock"sv,
+			".nif"sv, R"(\)"sv, "e"sv, "Landscape\\Rocks\\RockCliff01.nif"sv, "Landscape\\Rocks\\RockCliff01.nif."sv };
+
+		for (std::size_t i = 0; i < 20'000; ++i) {
+			auto path = std::string(folders[std::uniform_int_distribution<std::size_t>(0, folders.size() - 1)(rng)]) +
+			            std::string(names[std::uniform_int_distribution<std::size_t>(0, names.size() - 1)(rng)]) +
+			            std::to_string(std::uniform_int_distribution(1, 20)(rng)) + ".nif";
+			if (rng() % 4 == 0) {
+				for (auto& ch : path) {
+					ch = flip_case(ch);
+				}
+			}
+
+			for (const auto needle : needles) {
+				check(path, needle);
+			}
+			// a substring of the path itself, and the same with its last character changed
+			const auto pos = std::uniform_int_distribution<std::size_t>(0, path.size() - 1)(rng);
+			auto       needle = path.substr(pos, std::uniform_int_distribution<std::size_t>(1, path.size() - pos)(rng));
+			check(path, needle);
+			needle.back() = near_miss(needle.back());
+			check(path, needle);
+		}
+	}
+}
+
+// SeasonsStringSearchCheck
+// Compares StringSearch::icontains and icontains_scalar with clib_util::string::icontains on tail, needle length and path cases.
+// Exits with 1 on any mismatch. Throughput against the old function is in SeasonsBenchmark icontains.
+int main()
+{
+	check_lengths();
+	check_paths();
+
+	std::printf("cases\tmismatches\n%zu\t%zu\n", cases, mismatches);
+
+	return mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,604 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <ankerl/unordered_dense.h>
+
+#include "ClibString.h"
+#include "FormCatalog.h"
+#include "FormResolver.h"
+#include "FormSwapParser.h"
+#include "PerfectHash.h"
+#include "SeasonSwaps.h"
+#include "StringSearch.h"
+#include "SwapGenerator.h"
+
+using namespace std::literals;
+
+namespace
+{
+	// fixed seed, so every run benchmarks the same data
+	std::mt19937 rng{ 0x5EA5 };
+
+	// results are folded into this so the optimizer can't drop the work
+	volatile std::uint64_t sink = 0;
+
+	std::vector<std::string_view> filters;
+	std::vector<std::string_view> swapFiles;
+
+	// runs a_func, which processes a_items items per call, for at least minTime and prints the fastest batch
+	template <class F>
+	void run(std::string_view a_name, std::size_t a_items, F&& a_func)
+	{
+		if (!filters.empty() && std::ranges::none_of(filters, [&](const auto filter) { return a_name.find(filter) != std::string_view::npos; })) {
+			return;
+		}
+
+		constexpr auto        minTime = 200ms;
+		constexpr std::size_t minBatches = 3;
+
+		a_func();  // warm up
+
+		double      best = std::numeric_limits<double>::max();
+		std::size_t batches = 0;
+		const auto  start = std::chrono::steady_clock::now();
+		while (batches < minBatches || std::chrono::steady_clock::now() - start < minTime) {
+			const auto batchStart = std::chrono::steady_clock::now();
+			sink = sink + a_func();
+			best = std::min(best, std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - batchStart).count());
+			++batches;
+		}
+
+		const auto nsPerItem = best / static_cast<double>(a_items);
+		std::printf("%.*s\t%zu\t%.3f\t%.2f\n", static_cast<int>(a_name.size()), a_name.data(), a_items, nsPerItem, 1e3 / nsPerItem);
+	}
+
+	std::uint32_t random_formID()
+	{
+		const auto plugin = std::uniform_int_distribution<std::uint32_t>(0, 0xFD)(rng);
+		return (plugin << 24) | std::uniform_int_distribution<std::uint32_t>(0x800, 0xFFFFFF)(rng);
+	}
+
+	// FormSwapMap main swaps, one MapPair<RE::FormID> per record type
+	void bench_lookup(std::size_t a_size)
+	{
+		ankerl::unordered_dense::map<std::uint32_t, std::uint32_t> map;
+		map.reserve(a_size);
+		while (map.size() < a_size) {
+			map.emplace(random_formID(), random_formID());
+		}
+
+		constexpr std::size_t lookups = 1 << 20;
+
+		std::vector<std::uint32_t> hits;
+		hits.reserve(lookups);
+		for (const auto& [base, swap] : map) {
+			hits.push_back(base);
+		}
+		while (hits.size() < lookups) {
+			hits.push_back(hits[std::uniform_int_distribution<std::size_t>(0, a_size - 1)(rng)]);
+		}
+		std::ranges::shuffle(hits, rng);
+
+		std::vector<std::uint32_t> misses;
+		misses.reserve(lookups);
+		while (misses.size() < lookups) {
+			if (const auto formID = random_formID(); !map.contains(formID)) {
+				misses.push_back(formID);
+			}
+		}
+
+		const auto find = [&](const std::vector<std::uint32_t>& a_formIDs) {
+			std::uint64_t sum = 0;
+			for (const auto formID : a_formIDs) {
+				if (const auto it = map.find(formID); it != map.end()) {
+					sum += it->second;
+				}
+			}
+			return sum;
+		};
+
+		const auto size = std::to_string(a_size / 1000) + "k";
+		run("lookup/" + size + "/hit", lookups, [&] { return find(hits); });
+		run("lookup/" + size + "/miss", lookups, [&] { return find(misses); });
+
+		// same swaps frozen into the static table the main WIN formswap is installed as
+		const std::vector<PerfectHash::Map::value_type> pairs(map.begin(), map.end());
+
+		PerfectHash::Map perfectHash;
+		perfectHash.Build(pairs);
+
+		const auto find_static = [&](const std::vector<std::uint32_t>& a_formIDs) {
+			std::uint64_t sum = 0;
+			for (const auto formID : a_formIDs) {
+				sum += perfectHash.find(formID);
+			}
+			return sum;
+		};
+
+		run("perfect_hash/" + size + "/hit", lookups, [&] { return find_static(hits); });
+		run("perfect_hash/" + size + "/miss", lookups, [&] { return find_static(misses); });
+	}
+
+	// plugins get consecutive load order indices as they are first seen, editorIDs don't resolve
+	class FileLoadOrder final : public FormResolver::ILoadOrder
+	{
+	public:
+		[[nodiscard]] std::optional<std::uint32_t> GetPluginPrefix(std::string_view a_plugin) const override
+		{
+			const auto [it, inserted] = _prefixes.try_emplace(std::string(a_plugin), static_cast<std::uint32_t>(_prefixes.size()) << 24);
+			return it->second;
+		}
+
+		[[nodiscard]] std::pair<std::string, std::uint32_t> Remap(std::string_view a_plugin, std::uint32_t a_localID) const override
+		{
+			return { std::string(a_plugin), a_localID };
+		}
+
+		[[nodiscard]] bool          HasRemapping() const override { return false; }
+		[[nodiscard]] std::uint32_t LookupEditorID(std::string_view) const override { return 0; }
+
+	private:
+		mutable ankerl::unordered_dense::map<std::string, std::uint32_t> _prefixes;
+	};
+
+	// MapPair<RE::FormID> against PerfectHash::Map on the sections of a real formswap ini, build and hit lookups
+	void bench_swap_file(std::string_view a_path)
+	{
+		// FormSwapMap::recordTypeNames
+		static constexpr std::array<std::string_view, 8> sections{ "LandTextures"sv, "Activators"sv, "Furniture"sv, "MovableStatics"sv, "Statics"sv, "Trees"sv, "Flora"sv, "VisualEffects"sv };
+
+		const std::filesystem::path      path(a_path);
+		const FormSwapParser::MappedFile file(path);
+		if (!file.is_open()) {
+			std::fprintf(stderr, "couldn't read %.*s\n", static_cast<int>(a_path.size()), a_path.data());
+			return;
+		}
+
+		FormSwapParser::Document document;
+		FormSwapParser::Parse(file.data(), sections, document);
+
+		std::vector<FormSwapParser::FormRef> refs;
+		refs.reserve(document.entries.size() * 2);
+		for (const auto& entry : document.entries) {
+			refs.push_back(entry.base);
+			refs.push_back(entry.swap);
+		}
+
+		std::vector<std::uint32_t> formIDs(refs.size());
+		const FileLoadOrder        loadOrder;
+		FormResolver::Resolver(loadOrder).Resolve(refs, formIDs);
+
+		std::array<ankerl::unordered_dense::map<std::uint32_t, std::uint32_t>, sections.size()> maps;
+		for (std::size_t i = 0; i < document.entries.size(); ++i) {
+			if (formIDs[i * 2] != 0 && formIDs[i * 2 + 1] != 0) {
+				maps[document.entries[i].section].insert_or_assign(formIDs[i * 2], formIDs[i * 2 + 1]);
+			}
+		}
+
+		const auto name = path.stem().string();
+
+		for (std::size_t i = 0; i < sections.size(); ++i) {
+			const auto& map = maps[i];
+			if (map.empty()) {
+				continue;
+			}
+
+			const std::vector<PerfectHash::Map::value_type> pairs(map.begin(), map.end());
+
+			const auto prefix = name + "/" + std::string(sections[i]) + "/";
+
+			run(prefix + "map_build", pairs.size(), [&] {
+				ankerl::unordered_dense::map<std::uint32_t, std::uint32_t> built;
+				built.reserve(pairs.size());
+				for (const auto& [formID, swapFormID] : pairs) {
+					built.insert_or_assign(formID, swapFormID);
+				}
+				return built.size();
+			});
+
+			PerfectHash::Map perfectHash;
+			run(prefix + "perfect_hash_build", pairs.size(), [&] {
+				perfectHash.Build(pairs);
+				return perfectHash.size();
+			});
+
+			constexpr std::size_t lookups = 1 << 20;
+
+			std::vector<std::uint32_t> hits;
+			hits.reserve(lookups);
+			while (hits.size() < lookups) {
+				hits.push_back(pairs[std::uniform_int_distribution<std::size_t>(0, pairs.size() - 1)(rng)].first);
+			}
+
+			run(prefix + "map", lookups, [&] {
+				std::uint64_t sum = 0;
+				for (const auto formID : hits) {
+					if (const auto it = map.find(formID); it != map.end()) {
+						sum += it->second;
+					}
+				}
+				return sum;
+			});
+			run(prefix + "perfect_hash", lookups, [&] {
+				std::uint64_t sum = 0;
+				for (const auto formID : hits) {
+					sum += perfectHash.find(formID);
+				}
+				return sum;
+			});
+		}
+	}
+
+	// per season MapPair<RE::FormID> against the combined SeasonSwaps::Table, every batch reads the next season
+	// every base is swapped in winter, and half of them in each other season
+	void bench_season_swaps(std::size_t a_size)
+	{
+		std::array<ankerl::unordered_dense::map<std::uint32_t, std::uint32_t>, SeasonSwaps::seasonCount> maps;
+		std::vector<SeasonSwaps::Entry>                                                               entries;
+
+		std::vector<std::uint32_t> bases;
+		bases.reserve(a_size);
+		while (maps[0].size() < a_size) {
+			const auto base = random_formID();
+			if (!maps[0].emplace(base, random_formID()).second) {
+				continue;
+			}
+			bases.push_back(base);
+			for (std::size_t season = 1; season < maps.size(); ++season) {
+				if (std::uniform_int_distribution(0, 1)(rng) != 0) {
+					maps[season].emplace(base, random_formID());
+				}
+			}
+		}
+		for (std::size_t season = 0; season < maps.size(); ++season) {
+			for (const auto& [base, swap] : maps[season]) {
+				entries.push_back({ base, swap, 4, static_cast<std::uint8_t>(season) });
+			}
+		}
+
+		SeasonSwaps::Table table;
+		table.Build(entries);
+
+		constexpr std::size_t lookups = 1 << 20;
+
+		std::vector<std::uint32_t> formIDs;
+		formIDs.reserve(lookups);
+		while (formIDs.size() < lookups) {
+			formIDs.push_back(bases[std::uniform_int_distribution<std::size_t>(0, a_size - 1)(rng)]);
+		}
+
+		const auto size = std::to_string(a_size / 1000) + "k";
+
+		std::size_t season = 0;
+		run("season_maps/" + size, lookups, [&] {
+			const auto&   map = maps[season++ % maps.size()];
+			std::uint64_t sum = 0;
+			for (const auto formID : formIDs) {
+				if (const auto it = map.find(formID); it != map.end()) {
+					sum += it->second;
+				}
+			}
+			return sum;
+		});
+
+		season = 0;
+		run("season_table/" + size, lookups, [&] {
+			const auto    column = season++ % SeasonSwaps::seasonCount;
+			std::uint64_t sum = 0;
+			for (const auto formID : formIDs) {
+				sum += table.find(4, column, formID);
+			}
+			return sum;
+		});
+	}
+
+	constexpr std::array plugins{ "Skyrim.esm"sv, "Dawnguard.esm"sv, "Dragonborn.esm"sv, "SnowOverSkyrim.esp"sv, "Majestic Mountains.esp"sv, "Cathedral Landscapes.esp"sv };
+
+	// 0x1234~Plugin.esp, with one in eight refs by editorID
+	std::string random_form()
+	{
+		if (std::uniform_int_distribution(0, 7)(rng) == 0) {
+			return "SnowRockCliff0" + std::to_string(std::uniform_int_distribution(0, 99999)(rng));
+		}
+		char buffer[16];
+		std::snprintf(buffer, sizeof(buffer), "0x%X", std::uniform_int_distribution<std::uint32_t>(0x800, 0xFFFFFF)(rng));
+		return std::string(buffer) + "~" + std::string(plugins[std::uniform_int_distribution<std::size_t>(0, plugins.size() - 1)(rng)]);
+	}
+
+	void bench_parse()
+	{
+		constexpr std::size_t entries = 100'000;
+
+		static constexpr std::array<std::string_view, 3> sections{ "Statics"sv, "Trees"sv, "LandTextures"sv };
+
+		std::vector<std::string> forms;
+		forms.reserve(entries);
+		std::string ini{ "\xEF\xBB\xBF" };
+		for (std::size_t i = 0; i < entries; ++i) {
+			if (i % (entries / sections.size()) == 0) {
+				ini.append("[").append(sections[i / (entries / sections.size()) % sections.size()]).append("]\n");
+			}
+			const auto& base = forms.emplace_back(random_form());
+			ini.append(";BaseEDID|SnowEDID\n").append(base).append("|").append(random_form()).append("\n");
+		}
+
+		run("parse_form", entries, [&] {
+			std::uint64_t           sum = 0;
+			FormSwapParser::FormRef ref;
+			for (const auto& form : forms) {
+				if (FormSwapParser::parse_form(form, ref)) {
+					sum += ref.localID;
+				}
+			}
+			return sum;
+		});
+
+		FormSwapParser::Document document;
+		run("Parse/100k", entries, [&] {
+			FormSwapParser::Parse(ini, sections, document);
+			return document.entries.size();
+		});
+	}
+
+	// a fixed load order, read only so parallel resolves can share it
+	class PluginLoadOrder final : public FormResolver::ILoadOrder
+	{
+	public:
+		explicit PluginLoadOrder(std::span<const std::string_view> a_plugins)
+		{
+			for (std::uint32_t i = 0; i < a_plugins.size(); ++i) {
+				_prefixes.emplace(a_plugins[i], i << 24);
+			}
+		}
+
+		[[nodiscard]] std::optional<std::uint32_t> GetPluginPrefix(std::string_view a_plugin) const override
+		{
+			const auto it = _prefixes.find(a_plugin);
+			return it != _prefixes.end() ? std::optional(it->second) : std::nullopt;
+		}
+
+		[[nodiscard]] std::pair<std::string, std::uint32_t> Remap(std::string_view a_plugin, std::uint32_t a_localID) const override
+		{
+			return { std::string(a_plugin), a_localID };
+		}
+
+		[[nodiscard]] bool          HasRemapping() const override { return false; }
+		[[nodiscard]] std::uint32_t LookupEditorID(std::string_view) const override { return 0; }
+
+	private:
+		ankerl::unordered_dense::map<std::string_view, std::uint32_t> _prefixes;
+	};
+
+	// std::execution::par in SeasonManager::LoadSeasonData, libstdc++ runs that serially without TBB so workers are started here
+	template <class F>
+	void parallel_for(std::size_t a_count, F&& a_func)
+	{
+		std::atomic<std::size_t> next{ 0 };
+		{
+			std::vector<std::jthread> workers(std::min<std::size_t>(a_count, std::max(1u, std::thread::hardware_concurrency())));
+			for (auto& worker : workers) {
+				worker = std::jthread([&] {
+					for (auto i = next++; i < a_count; i = next++) {
+						a_func(i);
+					}
+				});
+			}
+		}
+	}
+
+	// Season::ParseConfig on every season ini, then the per season merge in file order and SeasonSwaps::Table::Build
+	// files cycle through the seasons, bases come from a shared pool so later files override earlier ones
+	void bench_load(std::size_t a_files, std::size_t a_entriesPerFile)
+	{
+		// FormSwapMap::recordTypeNames
+		static constexpr std::array<std::string_view, SeasonSwaps::typeCount> sections{ "LandTextures"sv, "Activators"sv, "Furniture"sv, "MovableStatics"sv, "Statics"sv, "Trees"sv, "Flora"sv, "VisualEffects"sv };
+
+		std::vector<std::string> bases(a_entriesPerFile * 2);
+		for (auto& base : bases) {
+			base = random_form();
+		}
+
+		std::vector<std::string> files(a_files);
+		for (auto& ini : files) {
+			ini = "\xEF\xBB\xBF[Worldspaces]\nTamriel\n";
+			for (std::size_t i = 0; i < a_entriesPerFile; ++i) {
+				if (i % (a_entriesPerFile / sections.size()) == 0 && i / (a_entriesPerFile / sections.size()) < sections.size()) {
+					ini.append("[").append(sections[i / (a_entriesPerFile / sections.size())]).append("]\n");
+				}
+				ini.append(bases[std::uniform_int_distribution<std::size_t>(0, bases.size() - 1)(rng)]).append("|").append(random_form()).append("\n");
+			}
+		}
+
+		const PluginLoadOrder loadOrder(plugins);
+
+		using Runs = std::array<std::vector<FormResolver::FormPair>, SeasonSwaps::typeCount>;
+
+		std::vector<Runs> runs(a_files);
+		const auto        parse = [&](std::size_t a_index) {
+			FormSwapParser::Document document;
+			FormSwapParser::Parse(files[a_index], sections, document);
+
+			runs[a_index] = {};
+			FormResolver::ResolveRuns(document, loadOrder, runs[a_index]);
+		};
+
+		const auto name = "load/" + std::to_string(a_files) + "x" + std::to_string(a_entriesPerFile) + "/";
+		const auto entries = a_files * a_entriesPerFile;
+
+		run(name + "parse_resolve", entries, [&] {
+			for (std::size_t i = 0; i < a_files; ++i) {
+				parse(i);
+			}
+			return runs.back()[4].size();
+		});
+		run(name + "parse_resolve_par", entries, [&] {
+			parallel_for(a_files, parse);
+			return runs.back()[4].size();
+		});
+
+		// FormSwapMap::MergeFormSwaps and ExtractFormSwaps per season, in file order
+		SeasonSwaps::Table table;
+		run(name + "merge_build", entries, [&] {
+			std::vector<SeasonSwaps::Entry> seasonEntries;
+			for (std::size_t season = 0; season < SeasonSwaps::seasonCount; ++season) {
+				std::array<ankerl::unordered_dense::map<std::uint32_t, std::uint32_t>, SeasonSwaps::typeCount> maps;
+				for (std::size_t file = season; file < a_files; file += SeasonSwaps::seasonCount) {
+					for (std::size_t type = 0; type < maps.size(); ++type) {
+						maps[type].reserve(maps[type].size() + runs[file][type].size());
+						for (const auto& [formID, swapFormID] : runs[file][type]) {
+							maps[type].insert_or_assign(formID, swapFormID);
+						}
+					}
+				}
+				for (std::size_t type = 0; type < maps.size(); ++type) {
+					for (const auto& [formID, swapFormID] : maps[type]) {
+						seasonEntries.push_back({ formID, swapFormID, static_cast<std::uint8_t>(type), static_cast<std::uint8_t>(season) });
+					}
+				}
+			}
+			table.Build(seasonEntries);
+			return table.size();
+		});
+	}
+
+	void bench_icontains()
+	{
+		constexpr std::size_t models = 100'000;
+
+		static constexpr std::array folders{ R"(landscape\rocks\)"sv, R"(architecture\whiterun\)"sv, R"(clutter\)"sv, R"(landscape\trees\)"sv, R"(dungeons\nordic\)"sv };
+		static constexpr std::array names{ "rockcliff"sv, "wrwoodplankfloor"sv, "bucket"sv, "treepineforest"sv, "norcavewall"sv, "snowdrift"sv, "icicle"sv };
+
+		std::vector<std::string> paths;
+		paths.reserve(models);
+		for (std::size_t i = 0; i < models; ++i) {
+			paths.push_back(std::string(folders[std::uniform_int_distribution<std::size_t>(0, folders.size() - 1)(rng)]) +
+							std::string(names[std::uniform_int_distribution<std::size_t>(0, names.size() - 1)(rng)]) +
+							std::to_string(std::uniform_int_distribution(1, 20)(rng)) + ".nif");
+		}
+
+		// SnowSwap model blacklist
+		static constexpr std::array needles{ R"(Effects\)"sv, R"(Sky\)"sv, R"(lod\)"sv, "WetRocks"sv, "DynDOLOD"sv, "Marker"sv, "Brazier"sv };
+
+		const auto match = [&](auto a_icontains) {
+			std::uint64_t count = 0;
+			for (const auto& path : paths) {
+				count += std::ranges::any_of(needles, [&](const auto needle) { return a_icontains(path, needle); });
+			}
+			return count;
+		};
+
+		run("icontains/blacklist", models, [&] { return match(StringSearch::icontains); });
+		run("icontains_scalar/blacklist", models, [&] { return match(StringSearch::icontains_scalar); });
+		run("clib_icontains/blacklist", models, [&] { return match(ClibString::icontains); });
+	}
+
+	void bench_land_textures()
+	{
+		constexpr std::size_t landTextures = 10'000;
+
+		using LAND_MATERIAL = FormCatalog::LAND_MATERIAL;
+
+		FormCatalog::Catalog catalog;
+		// snow variants GenerateLandTextureSnowVariant hands out
+		for (const auto formID : { 0x0000089Bu, 0x0006A1B1u, 0x0008B01Eu, 0x00000894u, 0x0001B082u, 0x0006A1AFu, 0x000F871Fu }) {
+			catalog.add({ .formID = formID, .localFormID = formID, .type = FormCatalog::TYPE::kLandTexture, .file = "Skyrim.esm"sv, .editorID = "LSnow"sv, .material = static_cast<std::uint32_t>(LAND_MATERIAL::kNoSnowVariant) });
+		}
+
+		static constexpr std::array editorIDs{ "LGrass"sv, "LDirt"sv, "LRocks"sv, "LMud"sv, "LRiverBed"sv, "LFrozenGrass"sv, "LTundra"sv };
+
+		std::vector<std::uint32_t> rows;
+		rows.reserve(landTextures);
+		while (rows.size() < landTextures) {
+			const auto formID = random_formID();
+			if (catalog.find(formID)) {
+				continue;
+			}
+			const auto editorID = std::string(editorIDs[std::uniform_int_distribution<std::size_t>(0, editorIDs.size() - 1)(rng)]) + std::to_string(rows.size());
+			rows.push_back(catalog.add({ .formID = formID,
+				.localFormID = formID & 0xFFFFFF,
+				.type = FormCatalog::TYPE::kLandTexture,
+				.file = plugins[formID % plugins.size()],
+				.editorID = editorID,
+				.material = std::uniform_int_distribution<std::uint32_t>(0, 4)(rng),
+				.flags = static_cast<std::uint8_t>(formID % 2 ? FormCatalog::ROW::kHasGrass : FormCatalog::ROW::kNone) }));
+		}
+
+		run("GenerateLandTextureSnowVariant", landTextures, [&] {
+			std::uint64_t count = 0;
+			for (const auto row : rows) {
+				if (const auto snowRow = SwapGenerator::GenerateLandTextureSnowVariant(catalog, row)) {
+					count += *snowRow;
+				}
+			}
+			return count;
+		});
+	}
+
+	// same container and contents as SeasonManager::monthToSeasons
+	void bench_month_to_season()
+	{
+		constexpr std::size_t lookups = 1 << 16;
+
+		const std::map<std::uint32_t, std::uint32_t> monthToSeasons{
+			{ 0, 1 }, { 1, 1 }, { 2, 2 }, { 3, 2 }, { 4, 2 }, { 5, 3 }, { 6, 3 }, { 7, 3 }, { 8, 4 }, { 9, 4 }, { 10, 4 }, { 11, 1 }
+		};
+
+		std::vector<std::uint32_t> months(lookups);
+		std::ranges::generate(months, [] { return std::uniform_int_distribution<std::uint32_t>(0, 11)(rng); });
+
+		run("monthToSeason", lookups, [&] {
+			std::uint64_t sum = 0;
+			for (const auto month : months) {
+				if (const auto it = monthToSeasons.find(month); it != monthToSeasons.end()) {
+					sum += it->second;
+				}
+			}
+			return sum;
+		});
+	}
+}
+
+// SeasonsBenchmark [--swaps formswap.ini]... [filter]...
+// benchmark, items per batch, ns per item, million items per second
+int main(int a_argc, char* a_argv[])
+{
+	for (int i = 1; i < a_argc; ++i) {
+		if (a_argv[i] == "--swaps"sv && i + 1 < a_argc) {
+			swapFiles.push_back(a_argv[++i]);
+		} else {
+			filters.push_back(a_argv[i]);
+		}
+	}
+
+	std::printf("benchmark\titems\tns_per_item\tmitems_per_s\n");
+
+	for (const std::size_t size : { 100'000, 500'000 }) {
+		bench_lookup(size);
+		bench_season_swaps(size);
+	}
+	bench_parse();
+	for (const auto& [files, entries] : { std::pair<std::size_t, std::size_t>{ 8, 25'000 }, { 64, 5'000 } }) {
+		bench_load(files, entries);
+	}
+	bench_icontains();
+	bench_land_textures();
+	bench_month_to_season();
+	for (const auto path : swapFiles) {
+		bench_swap_file(path);
+	}
+
+	return 0;
+}
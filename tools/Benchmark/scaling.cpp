@@ -0,0 +1,142 @@
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#	include <sys/resource.h>
+#endif
+
+#include "FormCatalog.h"
+#include "SwapGenerator.h"
+#include "SyntheticCatalog.h"
+
+namespace
+{
+	// process high-water mark, 0 where it isn't available
+	std::size_t get_max_rss_kb()
+	{
+#if defined(__unix__) || defined(__APPLE__)
+		rusage usage{};
+		if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#	ifdef __APPLE__
+			return static_cast<std::size_t>(usage.ru_maxrss) / 1024;
+#	else
+			return static_cast<std::size_t>(usage.ru_maxrss);
+#	endif
+		}
+#endif
+		return 0;
+	}
+
+	// counts what WriteFile would write, without the disk
+	class CountingBuffer final : public std::streambuf
+	{
+	public:
+		[[nodiscard]] std::size_t size() const { return _size; }
+
+	protected:
+		int_type overflow(int_type a_ch) override
+		{
+			++_size;
+			return traits_type::not_eof(a_ch);
+		}
+
+		std::streamsize xsputn(const char*, std::streamsize a_count) override
+		{
+			_size += static_cast<std::size_t>(a_count);
+			return a_count;
+		}
+
+	private:
+		std::size_t _size{ 0 };
+	};
+
+	double ms_since(std::chrono::steady_clock::time_point a_start)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - a_start).count();
+	}
+
+	// forms, stage, rows, swaps, ms, scratch allocations, scratch KB peak, process KB peak
+	void print(std::size_t a_forms, std::string_view a_stage, std::size_t a_rows, std::size_t a_swaps, double a_ms, const SwapGenerator::Stats& a_stats)
+	{
+		std::printf("%zu\t%.*s\t%zu\t%zu\t%.2f\t%zu\t%zu\t%zu\n", a_forms, static_cast<int>(a_stage.size()), a_stage.data(), a_rows, a_swaps, a_ms, a_stats.allocations, a_stats.peakBytes / 1024, get_max_rss_kb());
+	}
+
+	void run(std::size_t a_forms, const std::filesystem::path& a_saveDir)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		const auto catalog = SyntheticCatalog::Generate(a_forms);
+		print(a_forms, "catalog", catalog.size(), 0, ms_since(start), {});
+
+		if (!a_saveDir.empty()) {
+			const auto path = a_saveDir / ("FormCatalog_" + std::to_string(a_forms) + ".bin");
+			if (std::ofstream stream(path, std::ios::binary | std::ios::trunc); !stream || !catalog.Save(stream)) {
+				std::fprintf(stderr, "couldn't write %s\n", path.string().c_str());
+			}
+		}
+
+		const auto                 pipelineStart = std::chrono::steady_clock::now();
+		SwapGenerator::Regenerated regenerated;
+
+		for (std::size_t i = 0; i < SwapGenerator::sectionNames.size(); ++i) {
+			const auto type = static_cast<FormCatalog::TYPE>(i);
+			const auto rows = catalog.get_rows(type).size();
+
+			SwapGenerator::Stats stats;
+			start = std::chrono::steady_clock::now();
+			const auto& swaps = regenerated[i].emplace(SwapGenerator::GetSnowVariants(catalog, type, &stats));
+			print(a_forms, SwapGenerator::sectionNames[i], rows, swaps.size(), ms_since(start), stats);
+		}
+
+		start = std::chrono::steady_clock::now();
+		CountingBuffer buffer;
+		std::ostream   stream(&buffer);
+		SwapGenerator::WriteFile(stream, catalog, {}, regenerated);
+		print(a_forms, "WriteFile", 0, buffer.size() / 1024, ms_since(start), {});
+
+		print(a_forms, "total", catalog.size(), 0, ms_since(pipelineStart), {});
+	}
+
+	int usage()
+	{
+		std::fputs("usage: SeasonsScalingBenchmark [--save <dir>] [forms]...\n", stderr);
+		return 1;
+	}
+}
+
+// Runs winter swap generation against synthetic catalogs of increasing size
+// WriteFile's swaps column is the output size in KB, which is counted rather than written to disk.
+int main(int a_argc, char* a_argv[])
+{
+	std::filesystem::path    saveDir;
+	std::vector<std::size_t> sizes;
+	for (int i = 1; i < a_argc; ++i) {
+		if (std::string_view(a_argv[i]) == "--save") {
+			if (++i == a_argc) {
+				return usage();
+			}
+			saveDir = a_argv[i];
+		} else if (const auto forms = std::strtoull(a_argv[i], nullptr, 10); forms != 0) {
+			sizes.push_back(forms);
+		} else {
+			return usage();
+		}
+	}
+	if (sizes.empty()) {
+		sizes = { 10'000, 50'000, 100'000, 250'000, 500'000, 1'000'000 };
+	}
+
+	std::printf("forms\tstage\trows\tswaps\tms\tallocations\tscratch_kb\tmax_rss_kb\n");
+	for (const auto forms : sizes) {
+		run(forms, saveDir);
+	}
+
+	return 0;
+}
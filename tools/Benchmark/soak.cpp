@@ -0,0 +1,162 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "OriginalBases.h"
+
+namespace
+{
+	// exterior worldspace, every cell has the same number of references
+	constexpr std::int32_t worldSize = 128;
+	constexpr std::int32_t gridRadius = 2;  // uGridsToLoad 5
+	constexpr std::uint32_t refsPerCell = 400;
+	constexpr std::uint32_t baseCount = 20'000;
+
+	constexpr std::size_t reportInterval = 5'000;
+
+	std::uint32_t get_ref(std::uint32_t a_cell, std::uint32_t a_index)
+	{
+		return 0x01000000 | (a_cell * refsPerCell + a_index);
+	}
+
+	// stand-in form database, about a quarter of the bases have a winter swap
+	std::uint32_t get_base(std::uint32_t a_ref)
+	{
+		auto hash = static_cast<std::uint64_t>(a_ref) * 0x9E3779B97F4A7C15;
+		hash ^= hash >> 32;
+		return 0x00010000 + static_cast<std::uint32_t>(hash % baseCount);
+	}
+
+	bool is_swapped(std::uint32_t a_base)
+	{
+		return a_base % 4 == 0;
+	}
+
+	std::vector<std::uint32_t> get_grid(std::int32_t a_x, std::int32_t a_y)
+	{
+		std::vector<std::uint32_t> cells;
+		for (auto y = std::max(0, a_y - gridRadius); y <= std::min(worldSize - 1, a_y + gridRadius); ++y) {
+			for (auto x = std::max(0, a_x - gridRadius); x <= std::min(worldSize - 1, a_x + gridRadius); ++x) {
+				cells.push_back(static_cast<std::uint32_t>(y * worldSize + x));
+			}
+		}
+		return cells;
+	}
+
+	struct Result
+	{
+		std::size_t peakTracked{ 0 };
+		std::size_t peakAttached{ 0 };  // swapped references in attached cells
+		bool        bounded{ true };
+	};
+
+	// a_release: detached references are released like SeasonManager does on TESCellAttachDetachEvent
+	Result run(std::string_view a_policy, bool a_release, std::size_t a_steps, std::uint32_t a_seed)
+	{
+		std::mt19937 rng{ a_seed };
+
+		OriginalBases::Tracker tracker;
+
+		std::int32_t x = worldSize / 2;
+		std::int32_t y = worldSize / 2;
+
+		std::vector<std::uint32_t> attached;
+		std::vector<bool>          visited(static_cast<std::size_t>(worldSize) * worldSize);
+		std::size_t                cellsVisited = 0;
+		std::size_t                attachedSwaps = 0;
+
+		Result result;
+
+		const auto attach = [&](std::uint32_t a_cell) {
+			if (!visited[a_cell]) {
+				visited[a_cell] = true;
+				++cellsVisited;
+			}
+			// GetHandle
+			for (std::uint32_t i = 0; i < refsPerCell; ++i) {
+				const auto ref = get_ref(a_cell, i);
+				if (const auto base = get_base(ref); is_swapped(base)) {
+					tracker.Set(ref, base);
+					++attachedSwaps;
+				}
+			}
+		};
+
+		const auto detach = [&](std::uint32_t a_cell) {
+			for (std::uint32_t i = 0; i < refsPerCell; ++i) {
+				const auto ref = get_ref(a_cell, i);
+				if (is_swapped(get_base(ref))) {
+					if (a_release) {
+						tracker.Release(ref);
+					}
+					--attachedSwaps;
+				}
+			}
+		};
+
+		for (const auto cell : get_grid(x, y)) {
+			attach(cell);
+		}
+		attached = get_grid(x, y);
+
+		for (std::size_t step = 1; step <= a_steps; ++step) {
+			// walk to a neighbouring cell, with the odd fast travel
+			if (std::uniform_int_distribution(0, 99)(rng) == 0) {
+				x = std::uniform_int_distribution(0, worldSize - 1)(rng);
+				y = std::uniform_int_distribution(0, worldSize - 1)(rng);
+			} else {
+				x = std::clamp(x + std::uniform_int_distribution(-1, 1)(rng), 0, worldSize - 1);
+				y = std::clamp(y + std::uniform_int_distribution(-1, 1)(rng), 0, worldSize - 1);
+			}
+
+			const auto grid = get_grid(x, y);
+			for (const auto cell : attached) {
+				if (std::ranges::find(grid, cell) == grid.end()) {
+					detach(cell);
+				}
+			}
+			for (const auto cell : grid) {
+				if (std::ranges::find(attached, cell) == attached.end()) {
+					attach(cell);
+				}
+			}
+			attached = grid;
+
+			const auto tracked = tracker.size();
+			result.peakTracked = std::max(result.peakTracked, tracked);
+			result.peakAttached = std::max(result.peakAttached, attachedSwaps);
+			if (a_release && tracked > attachedSwaps) {
+				result.bounded = false;
+			}
+
+			if (step % reportInterval == 0 || step == a_steps) {
+				std::printf("%.*s\t%zu\t%zu\t%zu\t%zu\t%zu\t%.1f\n", static_cast<int>(a_policy.size()), a_policy.data(), step, cellsVisited, attachedSwaps, tracked, tracker.capacity(), static_cast<double>(tracker.get_memory_usage()) / 1024.0);
+			}
+		}
+
+		return result;
+	}
+}
+
+// SeasonsOriginalsSoak [steps] [seed]
+// Walks a synthetic worldspace cell by cell and reports how many original bases stay tracked.
+// "release" evicts references on detach, "keep" never does, like the tracking before cell detach eviction.
+// Exits with 1 if released tracking ever holds more references than the attached cells contain.
+int main(int a_argc, char* a_argv[])
+{
+	const std::size_t   steps = a_argc > 1 ? std::strtoull(a_argv[1], nullptr, 10) : 50'000;
+	const std::uint32_t seed = a_argc > 2 ? static_cast<std::uint32_t>(std::strtoul(a_argv[2], nullptr, 10)) : 0x5EA5;
+
+	std::printf("policy\tstep\tcells_visited\tattached_swaps\ttracked\tcapacity\tkb\n");
+
+	const auto released = run("release", true, steps, seed);
+	const auto kept = run("keep", false, steps, seed);
+
+	std::printf("# peak tracked: release %zu (peak attached %zu), keep %zu\n", released.peakTracked, released.peakAttached, kept.peakTracked);
+
+	return released.bounded ? 0 : 1;
+}
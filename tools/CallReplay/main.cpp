@@ -0,0 +1,229 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <ankerl/unordered_dense.h>
+
+#include "CallTrace.h"
+#include "FormCatalog.h"
+#include "FormResolver.h"
+#include "FormSwapParser.h"
+
+namespace
+{
+	// FormSwapMap::recordTypeNames
+	constexpr std::array<std::string_view, 8> sectionNames{ "LandTextures", "Activators", "Furniture", "MovableStatics", "Statics", "Trees", "Flora", "VisualEffects" };
+
+	// SEASON, index 0 is unused
+	constexpr std::array<std::string_view, 5> seasonSuffixes{ "", "_WIN", "_SPR", "_SUM", "_AUT" };
+
+	std::string to_lower(std::string_view a_str)
+	{
+		std::string str(a_str);
+		std::ranges::transform(str, str.begin(), [](char a_ch) { return a_ch >= 'A' && a_ch <= 'Z' ? static_cast<char>(a_ch + ('a' - 'A')) : a_ch; });
+		return str;
+	}
+
+	// plugin prefixes and editorIDs from the catalog rows, so only plugins with generated record types resolve
+	class CatalogLoadOrder final : public FormResolver::ILoadOrder
+	{
+	public:
+		explicit CatalogLoadOrder(const FormCatalog::Catalog& a_catalog)
+		{
+			for (std::uint32_t row = 0; row < a_catalog.size(); ++row) {
+				const auto formID = a_catalog.formIDs[row];
+				const auto prefix = (formID >> 24) == 0xFE ? formID & 0xFFFFF000 : formID & 0xFF000000;
+				_prefixes.try_emplace(to_lower(a_catalog.get_file(row)), prefix);
+				if (const auto editorID = a_catalog.get_editorID(row); !editorID.empty()) {
+					_editorIDs.try_emplace(to_lower(editorID), formID);
+				}
+			}
+		}
+
+		[[nodiscard]] std::optional<std::uint32_t> GetPluginPrefix(std::string_view a_plugin) const override
+		{
+			const auto it = _prefixes.find(to_lower(a_plugin));
+			return it != _prefixes.end() ? std::optional(it->second) : std::nullopt;
+		}
+
+		[[nodiscard]] std::pair<std::string, std::uint32_t> Remap(std::string_view a_plugin, std::uint32_t a_localID) const override
+		{
+			return { std::string(a_plugin), a_localID };
+		}
+
+		[[nodiscard]] bool HasRemapping() const override { return false; }
+
+		[[nodiscard]] std::uint32_t LookupEditorID(std::string_view a_editorID) const override
+		{
+			const auto it = _editorIDs.find(to_lower(a_editorID));
+			return it != _editorIDs.end() ? it->second : 0;
+		}
+
+	private:
+		ankerl::unordered_dense::map<std::string, std::uint32_t> _prefixes;
+		ankerl::unordered_dense::map<std::string, std::uint32_t> _editorIDs;
+	};
+
+	using SwapTable = ankerl::unordered_dense::map<std::uint32_t, std::uint32_t>;
+
+	std::size_t get_season(std::string_view a_path)
+	{
+		const auto stem = to_lower(a_path.substr(0, a_path.rfind('.')));
+		for (std::size_t i = 1; i < seasonSuffixes.size(); ++i) {
+			if (stem.ends_with(to_lower(seasonSuffixes[i]))) {
+				return i;
+			}
+		}
+		return 0;
+	}
+
+	// later files override earlier ones, pass MainFormSwap_WIN.ini first
+	bool load_swaps(const char* a_path, const CatalogLoadOrder& a_loadOrder, std::array<SwapTable, seasonSuffixes.size()>& a_tables)
+	{
+		const auto season = get_season(a_path);
+		if (season == 0) {
+			std::fprintf(stderr, "%s has no season suffix, skipping\n", a_path);
+			return true;
+		}
+
+		const FormSwapParser::MappedFile file(a_path);
+		if (!file.is_open()) {
+			std::fprintf(stderr, "couldn't read %s\n", a_path);
+			return false;
+		}
+
+		FormSwapParser::Document document;
+		FormSwapParser::Parse(file.data(), sectionNames, document);
+
+		std::vector<FormSwapParser::FormRef> refs;
+		refs.reserve(document.entries.size() * 2);
+		for (const auto& entry : document.entries) {
+			refs.push_back(entry.base);
+			refs.push_back(entry.swap);
+		}
+
+		std::vector<std::uint32_t> formIDs(refs.size());
+		FormResolver::Resolver(a_loadOrder).Resolve(refs, formIDs);
+
+		std::size_t resolved = 0;
+		for (std::size_t i = 0; i < formIDs.size(); i += 2) {
+			if (formIDs[i] != 0 && formIDs[i + 1] != 0) {
+				a_tables[season].insert_or_assign(formIDs[i], formIDs[i + 1]);
+				++resolved;
+			}
+		}
+
+		std::printf("%s : %zu/%zu swaps resolved\n", a_path, resolved, document.entries.size());
+		return true;
+	}
+
+	int usage()
+	{
+		std::fputs("usage: SeasonsCallReplay <FormCatalog.bin> <calls.bin> <formswap.ini>... [--iterations N]\n", stderr);
+		return 1;
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	if (a_argc < 4) {
+		return usage();
+	}
+
+	std::size_t              iterations = 10;
+	std::vector<const char*> iniPaths;
+	for (int i = 3; i < a_argc; ++i) {
+		if (std::string_view(a_argv[i]) == "--iterations" && i + 1 < a_argc) {
+			iterations = std::max<std::size_t>(1, std::strtoull(a_argv[++i], nullptr, 10));
+		} else {
+			iniPaths.push_back(a_argv[i]);
+		}
+	}
+
+	FormCatalog::Catalog catalog;
+	if (std::ifstream stream(a_argv[1], std::ios::binary); !stream || !catalog.Load(stream)) {
+		std::fprintf(stderr, "couldn't read form catalog %s\n", a_argv[1]);
+		return 1;
+	}
+
+	std::vector<CallTrace::Record> records;
+	if (std::ifstream stream(a_argv[2], std::ios::binary); !stream || !CallTrace::Read(stream, records)) {
+		std::fprintf(stderr, "couldn't read call recording %s\n", a_argv[2]);
+		return 1;
+	}
+
+	const CatalogLoadOrder                          loadOrder(catalog);
+	std::array<SwapTable, seasonSuffixes.size()> tables;
+	for (const auto path : iniPaths) {
+		if (!load_swaps(path, loadOrder, tables)) {
+			return 1;
+		}
+	}
+
+	struct Result
+	{
+		std::size_t calls{ 0 };
+		std::size_t hits{ 0 };
+		std::size_t skipped{ 0 };  // not replayable without the game
+		double      seconds{ 0.0 };
+	};
+	std::array<Result, static_cast<std::size_t>(CallTrace::HOOK::kTotal)> results{};
+
+	// replay each hook's calls in recorded order, so the lookup pattern matches the game's
+	for (std::size_t hook = 0; hook < results.size(); ++hook) {
+		auto& result = results[hook];
+
+		std::vector<std::pair<std::uint8_t, std::uint32_t>> lookups;
+		for (const auto& record : records) {
+			if (static_cast<std::size_t>(record.hook) != hook) {
+				continue;
+			}
+			++result.calls;
+			switch (record.hook) {
+			case CallTrace::HOOK::kGetHandle:
+				lookups.emplace_back(record.season, record.base);
+				break;
+			case CallTrace::HOOK::kIsConsideredSnow:
+			case CallTrace::HOOK::kGetSpecularComponent:
+				lookups.emplace_back(record.season, record.form);
+				break;
+			default:
+				++result.skipped;
+				break;
+			}
+		}
+		if (lookups.empty()) {
+			continue;
+		}
+
+		std::size_t hits = 0;
+		const auto  start = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < iterations; ++i) {
+			hits = 0;
+			for (const auto& [season, formID] : lookups) {
+				if (season < tables.size() && tables[season].contains(formID)) {
+					++hits;
+				}
+			}
+		}
+		result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		result.hits = hits;
+	}
+
+	// one line per hook, tab separated for scripts
+	std::printf("hook\tcalls\tskipped\thits\tns_per_lookup\n");
+	for (std::size_t hook = 0; hook < results.size(); ++hook) {
+		const auto& [calls, hits, skipped, seconds] = results[hook];
+		const auto  lookups = (calls - skipped) * iterations;
+		std::printf("%s\t%zu\t%zu\t%zu\t%.2f\n", CallTrace::hookNames[hook], calls, skipped, hits, lookups ? seconds * 1e9 / static_cast<double>(lookups) : 0.0);
+	}
+
+	return 0;
+}
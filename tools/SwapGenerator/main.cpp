@@ -0,0 +1,63 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <string_view>
+#include <vector>
+
+#include "FormCatalog.h"
+#include "SwapGenerator.h"
+
+namespace
+{
+	int usage()
+	{
+		std::fputs("usage: SeasonsSwapGenerator <FormCatalog.bin> <MainFormSwap_WIN.ini>\n", stderr);
+		return 1;
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	if (a_argc != 3) {
+		return usage();
+	}
+
+	const std::string_view catalogPath{ a_argv[1] };
+	const std::string_view outputPath{ a_argv[2] };
+
+	FormCatalog::Catalog catalog;
+	if (std::ifstream stream(a_argv[1], std::ios::binary); !stream || !catalog.Load(stream)) {
+		std::fprintf(stderr, "couldn't read form catalog %.*s\n", static_cast<int>(catalogPath.size()), catalogPath.data());
+		return 1;
+	}
+
+	std::printf("%zu forms, %zu plugins\n", catalog.size(), catalog.fileNames.size());
+
+	const auto start = std::chrono::steady_clock::now();
+
+	SwapGenerator::Regenerated regenerated;
+
+	for (std::size_t i = 0; i < SwapGenerator::sectionNames.size(); ++i) {
+		SwapGenerator::Stats stats;
+		const auto&          swaps = regenerated[i].emplace(SwapGenerator::GetSnowVariants(catalog, static_cast<FormCatalog::TYPE>(i), &stats));
+
+		std::printf("\t[%.*s] : wrote %zu variants (%zu allocations, %zu KB peak)\n", static_cast<int>(SwapGenerator::sectionNames[i].size()), SwapGenerator::sectionNames[i].data(), swaps.size(), stats.allocations, stats.peakBytes / 1024);
+	}
+
+	const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+	std::vector<char> buffer(1 << 16);
+	std::ofstream     file;
+	file.rdbuf()->pubsetbuf(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+	file.open(a_argv[2], std::ios::binary | std::ios::trunc);
+	if (file) {
+		SwapGenerator::WriteFile(file, catalog, {}, regenerated);
+	}
+	if (!file || !file.flush()) {
+		std::fprintf(stderr, "couldn't write %.*s\n", static_cast<int>(outputPath.size()), outputPath.data());
+		return 1;
+	}
+
+	std::printf("generated in %lld ms\n", static_cast<long long>(elapsed.count()));
+	return 0;
+}